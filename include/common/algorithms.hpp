@@ -1,19 +1,120 @@
+#include <algorithm>
+#include <vector>
+
 namespace kittens {
 
-template <typename T, bool should_transpose_A = false, bool should_transpose_B = false>
-void cpu_matmul(T *A, T *B, T *C, int M, int N, int K) {
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < M; i++) {
-    for (int j = 0; j < N; j++) {
-      float sum = 0;
-      for (int k = 0; k < K; k++) {
-        T &a_elem = should_transpose_A ? A[k * M + i] : A[i * K + k];
-        T &b_elem = should_transpose_B ? B[j * K + k] : B[k * N + j];
-        auto product = base_types::convertor<float, T>::convert(a_elem * b_elem);
-        sum += product;
+namespace detail {
+/**
+ * @brief Blocking of the host reference GEMM.
+ *
+ * A MC x KC block of A and a KC x NC block of B are converted to fp32 once and packed into MR-row and
+ * NR-column panels, so the micro-kernel streams both with unit stride from L1/L2 no matter how A and B are
+ * laid out, and its MR x NR accumulators stay in vector registers. NR is a multiple of the 16 fp32 lanes of
+ * AVX-512 (two AVX2 registers), and the inner loop is written for the compiler to vectorize; build the host
+ * side with -march=native (or -mavx2 / -mavx512f) to get the wide instructions.
+ */
+struct cpu_gemm_blocking {
+  static constexpr int MR = 4, NR = 16;
+  static constexpr int MC = 128, NC = 256, KC = 256;
+};
+
+/**
+ * @brief acc[MR][NR] += a_panel^T * b_panel over kc steps, for packed panels of MR and NR values per step.
+ */
+template <typename Acc>
+inline void cpu_gemm_micro(const float *a_panel, const float *b_panel, int kc, Acc *acc, int ldacc) {
+  using B = cpu_gemm_blocking;
+  Acc c[B::MR][B::NR];
+  for (int i = 0; i < B::MR; i++)
+    for (int j = 0; j < B::NR; j++) c[i][j] = acc[i * ldacc + j];
+  for (int k = 0; k < kc; k++) {
+    const float *a = a_panel + k * B::MR;
+    const float *b = b_panel + k * B::NR;
+    for (int i = 0; i < B::MR; i++) {
+      const Acc ai = a[i];
+#pragma omp simd
+      for (int j = 0; j < B::NR; j++) c[i][j] += ai * Acc(b[j]);
+    }
+  }
+  for (int i = 0; i < B::MR; i++)
+    for (int j = 0; j < B::NR; j++) acc[i * ldacc + j] = c[i][j];
+}
+} // namespace detail
+
+/**
+ * @brief Host reference C = op(A) * op(B), with A M x K and B K x N after the optional transposes.
+ *
+ * Cache-blocked and packed (see detail::cpu_gemm_blocking), with OpenMP over output blocks. Inputs are
+ * converted to fp32 once while packing rather than per multiply, which is exact for every 16- and 8-bit
+ * type. Each output is summed over K in order within a thread, so results do not depend on the thread count.
+ *
+ * @tparam T Element type of A, B and C.
+ * @tparam should_transpose_A A is stored K x M.
+ * @tparam should_transpose_B B is stored N x K.
+ * @tparam Acc Accumulator type: float, or double for a reference that is tighter than any GPU kernel.
+ */
+template <typename T, bool should_transpose_A = false, bool should_transpose_B = false, typename Acc = float>
+void cpu_matmul(const T *A, const T *B, T *C, int M, int N, int K) {
+  using BL = detail::cpu_gemm_blocking;
+  const int blocks_m = (M + BL::MC - 1) / BL::MC;
+  const int blocks_n = (N + BL::NC - 1) / BL::NC;
+  auto a_at = [&](int i, int k) { return base_types::convertor<float, T>::convert(should_transpose_A ? A[size_t(k) * M + i] : A[size_t(i) * K + k]); };
+  auto b_at = [&](int k, int j) { return base_types::convertor<float, T>::convert(should_transpose_B ? B[size_t(j) * K + k] : B[size_t(k) * N + j]); };
+
+#pragma omp parallel
+  {
+    std::vector<float> a_pack(size_t(BL::MC) * BL::KC), b_pack(size_t(BL::KC) * BL::NC);
+    std::vector<Acc> acc(size_t(BL::MC) * BL::NC);
+#pragma omp for collapse(2) schedule(dynamic)
+    for (int bm = 0; bm < blocks_m; bm++) {
+      for (int bn = 0; bn < blocks_n; bn++) {
+        const int i0 = bm * BL::MC, mc = std::min(BL::MC, M - i0);
+        const int j0 = bn * BL::NC, nc = std::min(BL::NC, N - j0);
+        std::fill(acc.begin(), acc.end(), Acc(0));
+        for (int k0 = 0; k0 < K; k0 += BL::KC) {
+          const int kc = std::min(BL::KC, K - k0);
+          // A panel p holds rows i0 + MR * p + [0, MR) as kc steps of MR values; rows past M are zero
+          for (int p = 0; p < BL::MC / BL::MR; p++) {
+            float *dst = &a_pack[size_t(p) * BL::KC * BL::MR];
+            for (int k = 0; k < kc; k++)
+              for (int r = 0; r < BL::MR; r++) {
+                const int i = p * BL::MR + r;
+                dst[k * BL::MR + r] = i < mc ? a_at(i0 + i, k0 + k) : 0.f;
+              }
+          }
+          // B panel p holds columns j0 + NR * p + [0, NR) as kc steps of NR values; columns past N are zero
+          for (int p = 0; p < BL::NC / BL::NR; p++) {
+            float *dst = &b_pack[size_t(p) * BL::KC * BL::NR];
+            for (int k = 0; k < kc; k++)
+              for (int c = 0; c < BL::NR; c++) {
+                const int j = p * BL::NR + c;
+                dst[k * BL::NR + c] = j < nc ? b_at(k0 + k, j0 + j) : 0.f;
+              }
+          }
+          for (int pi = 0; pi * BL::MR < mc; pi++)
+            for (int pj = 0; pj * BL::NR < nc; pj++)
+              detail::cpu_gemm_micro(&a_pack[size_t(pi) * BL::KC * BL::MR], &b_pack[size_t(pj) * BL::KC * BL::NR], kc,
+                                     &acc[size_t(pi) * BL::MR * BL::NC + pj * BL::NR], BL::NC);
+        }
+        for (int i = 0; i < mc; i++)
+          for (int j = 0; j < nc; j++) C[size_t(i0 + i) * N + j0 + j] = base_types::convertor<T, float>::convert(float(acc[size_t(i) * BL::NC + j]));
       }
-      C[i * N + j] = base_types::convertor<T, float>::convert(sum);
     }
   }
 }
-} // namespace kittens
\ No newline at end of file
+
+/**
+ * @brief cpu_matmul() over a batch of independent problems stored back to back.
+ *
+ * A stride of 0 broadcasts that operand to every problem.
+ *
+ * @param stride_A[in] Elements between consecutive A matrices; M * K when each problem has its own.
+ * @param stride_B[in] Elements between consecutive B matrices; N * K when each problem has its own.
+ */
+template <typename T, bool should_transpose_A = false, bool should_transpose_B = false, typename Acc = float>
+void cpu_matmul_batched(const T *A, const T *B, T *C, int batch, int M, int N, int K, size_t stride_A, size_t stride_B) {
+  for (int b = 0; b < batch; b++) {
+    cpu_matmul<T, should_transpose_A, should_transpose_B, Acc>(A + b * stride_A, B + b * stride_B, C + b * size_t(M) * N, M, N, K);
+  }
+}
+} // namespace kittens
@@ -9,6 +9,13 @@
 #include <hip/hip_bf16.h>
 #include <limits>
 
+#ifdef KITTENS_EMULATOR
+// The fast-math intrinsics only exist on the device, so the host emulator maps them onto libm.
+inline float __expf(float x) { return expf(x); }
+inline float __logf(float x) { return logf(x); }
+inline float __log2f(float x) { return log2f(x); }
+#endif
+
 namespace kittens {
 
 /**
@@ -212,9 +219,9 @@ struct relu {
   static __device__ inline T op(const T &x) { return max(x, base_types::constants<T>::zero()); }
 };
 template <>
-__device__ inline float relu::op<float>(const float &x) { return max(x, 0.f); }
+__device__ inline float relu::op<float>(const float &x) { return fmaxf(x, 0.f); }
 template <>
-__device__ inline float2 relu::op<float2>(const float2 &x) { return float2{max(x.x, 0.f), max(x.y, 0.f)}; }
+__device__ inline float2 relu::op<float2>(const float2 &x) { return float2{fmaxf(x.x, 0.f), fmaxf(x.y, 0.f)}; }
 template <>
 __device__ inline bf16 relu::op<bf16>(const bf16 &x) { return __hmax(x, base_types::constants<bf16>::zero()); }
 template <>
@@ -364,7 +371,9 @@ struct max {
   static __device__ inline T op(const T &a, const T &b) { return ::max(a, b); }
 };
 template <>
-__device__ inline float2 max::op<float2>(const float2 &a, const float2 &b) { return float2{::max(a.x, b.x), ::max(a.y, b.y)}; }
+__device__ inline float max::op<float>(const float &a, const float &b) { return fmaxf(a, b); }
+template <>
+__device__ inline float2 max::op<float2>(const float2 &a, const float2 &b) { return float2{fmaxf(a.x, b.x), fmaxf(a.y, b.y)}; }
 template <>
 __device__ inline bf16 max::op<bf16>(const bf16 &a, const bf16 &b) { return __hmax(a, b); }
 template <>
@@ -388,7 +397,9 @@ struct min {
   static __device__ inline T op(const T &a, const T &b) { return ::min(a, b); }
 };
 template <>
-__device__ inline float2 min::op<float2>(const float2 &a, const float2 &b) { return float2{::min(a.x, b.x), ::min(a.y, b.y)}; }
+__device__ inline float min::op<float>(const float &a, const float &b) { return fminf(a, b); }
+template <>
+__device__ inline float2 min::op<float2>(const float2 &a, const float2 &b) { return float2{fminf(a.x, b.x), fminf(a.y, b.y)}; }
 template <>
 __device__ inline bf16 min::op<bf16>(const bf16 &a, const bf16 &b) { return __hmin(a, b); }
 template <>
@@ -15,6 +15,7 @@
 #include <hip/hip_bf16.h>
 #include <hip/hip_bfloat16.h>
 #include <hip/hip_fp16.h>
+#include <hip/hip_fp8.h>
 #include <string>
 
 // Don't use constexpr for now because it's not supported by certain operations
@@ -44,6 +45,22 @@ using bf16_2 = __hip_bfloat162;
  * @brief Packed word of two half-precision floating-point values.
  */
 using half_2 = __half2;
+/**
+ * @brief 8-bit floating-point type with 4 exponent and 3 mantissa bits, in the FNUZ variant MI300 MFMAs consume.
+ */
+using fp8e4m3 = __hip_fp8_e4m3_fnuz;
+/**
+ * @brief 8-bit floating-point type with 5 exponent and 2 mantissa bits, in the FNUZ variant MI300 MFMAs consume.
+ */
+using fp8e5m2 = __hip_fp8_e5m2_fnuz;
+/**
+ * @brief Packed word of four fp8e4m3 values.
+ */
+using fp8e4m3_4 = __hip_fp8x4_e4m3_fnuz;
+/**
+ * @brief Packed word of four fp8e5m2 values.
+ */
+using fp8e5m2_4 = __hip_fp8x4_e5m2_fnuz;
 
 namespace ducks {
 /**
@@ -53,9 +70,19 @@ namespace ducks {
  */
 namespace base_types {
 template <typename T>
-concept T2 = std::is_same_v<T, float2> || std::is_same_v<T, bf16_2> || std::is_same_v<T, half_2>;
+concept T2 = std::is_same_v<T, float2> || std::is_same_v<T, bf16_2> || std::is_same_v<T, half_2> || std::is_same_v<T, fp8e4m3_4> || std::is_same_v<T, fp8e5m2_4>;
+template <typename T>
+concept T1 = std::is_same_v<T, float> || std::is_same_v<T, bf16> || std::is_same_v<T, half> || std::is_same_v<T, fp8e4m3> || std::is_same_v<T, fp8e5m2>;
+/**
+ * @brief The 16-bit floating-point element types, which share the 32x32x8 MFMA operand format.
+ */
+template <typename T>
+concept sixteen_bit = std::is_same_v<T, bf16> || std::is_same_v<T, half>;
+/**
+ * @brief The 8-bit floating-point element types.
+ */
 template <typename T>
-concept T1 = std::is_same_v<T, float> || std::is_same_v<T, bf16> || std::is_same_v<T, half>;
+concept fp8 = std::is_same_v<T, fp8e4m3> || std::is_same_v<T, fp8e5m2>;
 
 } // namespace base_types
 } // namespace ducks
@@ -130,6 +157,27 @@ struct constants<half_2> {
   static __device__ inline todo_constexpr half_2 pos_infty() { return half_2{constants<half>::pos_infty(), constants<half>::pos_infty()}; }
   static __device__ inline todo_constexpr half_2 neg_infty() { return half_2{constants<half>::neg_infty(), constants<half>::neg_infty()}; }
 };
+// FNUZ fp8 has no infinities, so only zero and one are provided
+template <>
+struct constants<fp8e4m3> {
+  static __device__ inline constexpr fp8e4m3 zero() { return std::bit_cast<fp8e4m3>(uint8_t(0x00)); }
+  static __device__ inline constexpr fp8e4m3 one() { return std::bit_cast<fp8e4m3>(uint8_t(0x40)); }
+};
+template <>
+struct constants<fp8e5m2> {
+  static __device__ inline constexpr fp8e5m2 zero() { return std::bit_cast<fp8e5m2>(uint8_t(0x00)); }
+  static __device__ inline constexpr fp8e5m2 one() { return std::bit_cast<fp8e5m2>(uint8_t(0x40)); }
+};
+template <>
+struct constants<fp8e4m3_4> {
+  static __device__ inline constexpr fp8e4m3_4 zero() { return std::bit_cast<fp8e4m3_4>(uint32_t(0x00000000)); }
+  static __device__ inline constexpr fp8e4m3_4 one() { return std::bit_cast<fp8e4m3_4>(uint32_t(0x40404040)); }
+};
+template <>
+struct constants<fp8e5m2_4> {
+  static __device__ inline constexpr fp8e5m2_4 zero() { return std::bit_cast<fp8e5m2_4>(uint32_t(0x00000000)); }
+  static __device__ inline constexpr fp8e5m2_4 one() { return std::bit_cast<fp8e5m2_4>(uint32_t(0x40404040)); }
+};
 
 template <>
 struct constants<int> {
@@ -192,6 +240,34 @@ struct packing<half_2> {
   static __device__ inline todo_constexpr half_2 pack(const half &i) { return half_2{i, i}; } // this replication makes code cleaner later.
 };
 template <>
+struct packing<fp8e4m3> {
+  static __device__ inline constexpr int num() { return 1; }
+  using unpacked_type = fp8e4m3;
+  using packed_type = fp8e4m3_4;
+  static __device__ inline todo_constexpr fp8e4m3_4 pack(const fp8e4m3 &i) { return std::bit_cast<fp8e4m3_4>(uint32_t(std::bit_cast<uint8_t>(i)) * 0x01010101u); }
+};
+template <>
+struct packing<fp8e4m3_4> {
+  static __device__ inline constexpr int num() { return 4; }
+  using unpacked_type = fp8e4m3;
+  using packed_type = fp8e4m3_4;
+  static __device__ inline todo_constexpr fp8e4m3_4 pack(const fp8e4m3 &i) { return packing<fp8e4m3>::pack(i); } // this replication makes code cleaner later.
+};
+template <>
+struct packing<fp8e5m2> {
+  static __device__ inline constexpr int num() { return 1; }
+  using unpacked_type = fp8e5m2;
+  using packed_type = fp8e5m2_4;
+  static __device__ inline todo_constexpr fp8e5m2_4 pack(const fp8e5m2 &i) { return std::bit_cast<fp8e5m2_4>(uint32_t(std::bit_cast<uint8_t>(i)) * 0x01010101u); }
+};
+template <>
+struct packing<fp8e5m2_4> {
+  static __device__ inline constexpr int num() { return 4; }
+  using unpacked_type = fp8e5m2;
+  using packed_type = fp8e5m2_4;
+  static __device__ inline todo_constexpr fp8e5m2_4 pack(const fp8e5m2 &i) { return packing<fp8e5m2>::pack(i); } // this replication makes code cleaner later.
+};
+template <>
 struct packing<float> {
   static __device__ inline constexpr int num() { return 1; }
   using unpacked_type = float;
@@ -349,5 +425,55 @@ struct convertor<half_2, bf16_2> {
     return __float22half2_rn(__bfloat1622float2(u));
   }
 };
+
+// fp8 goes through fp32 both ways; the HIP constructors round to nearest even and saturate to the largest finite value
+template <ducks::base_types::fp8 T>
+struct convertor<T, float> {
+  static __host__ __device__ inline T convert(const float &u) {
+    return T(u);
+  }
+};
+template <ducks::base_types::fp8 U>
+struct convertor<float, U> {
+  static __host__ __device__ inline float convert(const U &u) {
+    return float(u);
+  }
+};
+template <ducks::base_types::fp8 T>
+struct convertor<T, bf16> {
+  static __host__ __device__ inline T convert(const bf16 &u) {
+    return T(__bfloat162float(u));
+  }
+};
+template <ducks::base_types::fp8 U>
+struct convertor<bf16, U> {
+  static __host__ __device__ inline bf16 convert(const U &u) {
+    return __float2bfloat16_rn(float(u));
+  }
+};
+template <>
+struct convertor<fp8e4m3_4, float4> {
+  static __host__ __device__ inline fp8e4m3_4 convert(const float4 &u) {
+    return fp8e4m3_4(u);
+  }
+};
+template <>
+struct convertor<float4, fp8e4m3_4> {
+  static __host__ __device__ inline float4 convert(const fp8e4m3_4 &u) {
+    return float4(u);
+  }
+};
+template <>
+struct convertor<fp8e5m2_4, float4> {
+  static __host__ __device__ inline fp8e5m2_4 convert(const float4 &u) {
+    return fp8e5m2_4(u);
+  }
+};
+template <>
+struct convertor<float4, fp8e5m2_4> {
+  static __host__ __device__ inline float4 convert(const fp8e5m2_4 &u) {
+    return float4(u);
+  }
+};
 } // namespace base_types
 } // namespace kittens
\ No newline at end of file
@@ -0,0 +1,270 @@
+/**
+ * @file
+ * @brief Benchmarking for the examples: per-launch timing from cold caches, roofline percentages, and
+ * CSV/JSON reports.
+ *
+ * An example's --bench mode hands bench_sweep() its shapes and a function that sets one up and times it
+ * with benchmark(); the sweep collects the results in a bench_report and writes bench_<kernel>.{csv,json}.
+ */
+
+#pragma once
+#include "check.hpp"
+#include "kernel_timer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace kittens {
+
+/**
+ * @brief Repeated timings of one kernel, in milliseconds.
+ */
+struct bench_stats {
+  float min_ms, median_ms, p95_ms, mean_ms;
+  int iters;
+};
+
+/**
+ * @brief Overwrites a buffer larger than the caches before each timed launch, so every launch reads its
+ * inputs from HBM as it would between layers of a model rather than from a cache warmed by the last run.
+ *
+ * The buffer is at least twice the L2 and at least 512 MB, which also covers the 256 MB Infinity Cache of
+ * MI300-class parts.
+ */
+class l2_flusher {
+private:
+  void *buffer;
+  size_t bytes;
+
+public:
+  inline l2_flusher() {
+    int device;
+    hipDeviceProp_t prop;
+    hipCheck(hipGetDevice(&device));
+    hipCheck(hipGetDeviceProperties(&prop, device));
+    bytes = std::max<size_t>(2 * size_t(prop.l2CacheSize), size_t(512) << 20);
+    hipCheck(hipMalloc(&buffer, bytes));
+  }
+  l2_flusher(const l2_flusher &) = delete;
+  l2_flusher &operator=(const l2_flusher &) = delete;
+  inline ~l2_flusher() { hipCheck(hipFree(buffer)); }
+
+  inline void flush() { hipCheck(hipMemsetAsync(buffer, 0, bytes)); }
+};
+
+/**
+ * @brief Times launch() one launch at a time and summarizes the distribution.
+ *
+ * Each launch is a region of a timer_pool, so the launches are enqueued back to back without a host
+ * sync between them, and the median and p95 are not smeared by averaging. The flush is enqueued before
+ * the region opens, so it is not part of the time.
+ *
+ * @param launch[in] Enqueues the kernel on the default stream; must be safe to run repeatedly.
+ * @param warmup[in] Untimed launches first, for code loading and clocks to settle.
+ * @param iters[in] Timed launches.
+ * @param flush_l2[in] Flush the caches before every timed launch.
+ */
+template <typename F>
+inline bench_stats benchmark(F &&launch, int warmup = 5, int iters = 50, bool flush_l2 = true) {
+  for (int i = 0; i < warmup; i++) launch();
+  std::unique_ptr<l2_flusher> flusher = flush_l2 ? std::make_unique<l2_flusher>() : nullptr;
+  timer_pool timers(nullptr, 2 * iters, /* keep_samples */ true);
+  for (int i = 0; i < iters; i++) {
+    if (flusher) flusher->flush();
+    auto region = timers.time("launch");
+    launch();
+  }
+  timers.resolve();
+  std::vector<float> times = timers.stats().at("launch").samples;
+  std::sort(times.begin(), times.end());
+  bench_stats s;
+  s.iters = iters;
+  s.min_ms = times.front();
+  s.median_ms = iters % 2 ? times[iters / 2] : (times[iters / 2 - 1] + times[iters / 2]) / 2;
+  s.p95_ms = times[std::max(0, int(std::ceil(0.95 * iters)) - 1)];
+  double sum = 0;
+  for (float t : times) sum += t;
+  s.mean_ms = sum / iters;
+  return s;
+}
+
+/**
+ * @brief Dense matrix-core throughput and HBM bandwidth of the current device, for roofline percentages.
+ *
+ * MFMA rates per CU per clock come from the gfx arch; KITTENS_PEAK_TFLOPS and KITTENS_PEAK_GBPS override
+ * the derived values, e.g. for parts with non-default clocks.
+ *
+ * @param bytes_per_element[in] Input element size: 2 for bf16/fp16, 1 for fp8.
+ */
+struct device_peak {
+  double tflops;
+  double gbps;
+
+  static inline device_peak query(int bytes_per_element) {
+    int device;
+    hipDeviceProp_t prop;
+    hipCheck(hipGetDevice(&device));
+    hipCheck(hipGetDeviceProperties(&prop, device));
+    const std::string arch = prop.gcnArchName;
+    // Dense 16-bit flops per CU per clock; fp8 runs at twice the rate where it exists
+    double flops_per_clock = 1024;
+    double gbps = 3277;
+    if (arch.rfind("gfx942", 0) == 0) flops_per_clock = 2048, gbps = 5300;
+    if (arch.rfind("gfx950", 0) == 0) flops_per_clock = 4096, gbps = 8000;
+    if (bytes_per_element == 1 && arch.rfind("gfx90a", 0) != 0) flops_per_clock *= 2;
+
+    device_peak p;
+    p.tflops = flops_per_clock * prop.multiProcessorCount * (prop.clockRate * 1e3) / 1e12;
+    p.gbps = gbps;
+    if (const char *v = std::getenv("KITTENS_PEAK_TFLOPS")) p.tflops = std::atof(v);
+    if (const char *v = std::getenv("KITTENS_PEAK_GBPS")) p.gbps = std::atof(v);
+    return p;
+  }
+};
+
+/**
+ * @brief One benchmarked kernel configuration.
+ */
+struct bench_result {
+  std::string kernel, dtype;
+  int m, n, k;
+  bench_stats stats;
+  double flops; ///< Useful floating point operations per launch.
+  double bytes; ///< Minimum HBM traffic per launch: every input read and every output written once.
+  device_peak peak;
+  int batch = 1; ///< Independent m x n x k problems per launch.
+
+  inline double tflops() const { return flops / (stats.median_ms * 1e-3) / 1e12; }
+  inline double gbps() const { return bytes / (stats.median_ms * 1e-3) / 1e9; }
+  /**
+   * @brief Achieved throughput as a percentage of the roofline at this shape's arithmetic intensity.
+   */
+  inline double roofline_pct() const {
+    const double bound = std::min(peak.tflops, flops / bytes * peak.gbps / 1e3);
+    return 100 * tflops() / bound;
+  }
+};
+
+/**
+ * @brief The bench_result of an M x N x K GEMM, counted in doubles so large shapes do not overflow.
+ *
+ * @param in_size[in] Bytes per element of A and B.
+ * @param out_size[in] Bytes per element of C.
+ * @param batch[in] GEMMs per launch.
+ * @param broadcast_b[in] All of them share one B, which is then read once.
+ */
+inline bench_result gemm_result(const std::string &kernel, const std::string &dtype, int M, int N, int K, const bench_stats &stats, int in_size, int out_size,
+                                int batch = 1, bool broadcast_b = false) {
+  const double flops = 2.0 * batch * M * N * K;
+  const double bytes = (double(batch) * M * K + double(broadcast_b ? 1 : batch) * N * K) * in_size + double(batch) * M * N * out_size;
+  return {kernel, dtype, M, N, K, stats, flops, bytes, device_peak::query(in_size), batch};
+}
+
+/**
+ * @brief Collects bench_results, echoes them as they come in, and writes them out as CSV and JSON.
+ */
+class bench_report {
+private:
+  std::vector<bench_result> results;
+
+public:
+  inline void add(const bench_result &r) {
+    results.push_back(r);
+    std::cout << "[" << r.kernel << " " << r.dtype << " " << (r.batch > 1 ? std::to_string(r.batch) + " x " : "") << r.m << "x" << r.n << "x" << r.k << "] median " << std::fixed
+              << std::setprecision(4) << r.stats.median_ms << " ms, p95 " << r.stats.p95_ms << " ms, " << std::setprecision(1)
+              << r.tflops() << " TFLOPS, " << r.gbps() << " GB/s, " << r.roofline_pct() << "% of roofline" << std::endl;
+  }
+
+  inline void write_csv(const std::string &path) const {
+    std::ofstream file(path);
+    file << "kernel,dtype,batch,m,n,k,iters,min_ms,median_ms,p95_ms,mean_ms,tflops,gbps,roofline_pct" << std::endl;
+    for (const auto &r : results) {
+      file << r.kernel << "," << r.dtype << "," << r.batch << "," << r.m << "," << r.n << "," << r.k << "," << r.stats.iters << "," << r.stats.min_ms << ","
+           << r.stats.median_ms << "," << r.stats.p95_ms << "," << r.stats.mean_ms << "," << r.tflops() << "," << r.gbps() << "," << r.roofline_pct()
+           << std::endl;
+    }
+  }
+
+  inline void write_json(const std::string &path) const {
+    std::ofstream file(path);
+    file << "[" << std::endl;
+    for (size_t i = 0; i < results.size(); i++) {
+      const auto &r = results[i];
+      file << "  {\"kernel\": \"" << r.kernel << "\", \"dtype\": \"" << r.dtype << "\", \"batch\": " << r.batch << ", \"m\": " << r.m << ", \"n\": " << r.n << ", \"k\": " << r.k
+           << ", \"iters\": " << r.stats.iters << ", \"min_ms\": " << r.stats.min_ms << ", \"median_ms\": " << r.stats.median_ms
+           << ", \"p95_ms\": " << r.stats.p95_ms << ", \"mean_ms\": " << r.stats.mean_ms << ", \"tflops\": " << r.tflops() << ", \"gbps\": " << r.gbps()
+           << ", \"roofline_pct\": " << r.roofline_pct() << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    file << "]" << std::endl;
+  }
+
+  /**
+   * @brief Writes <prefix>.csv and <prefix>.json.
+   */
+  inline void write(const std::string &prefix) const {
+    write_csv(prefix + ".csv");
+    write_json(prefix + ".json");
+    std::cout << "Wrote " << prefix << ".csv and " << prefix << ".json" << std::endl;
+  }
+};
+
+/**
+ * @brief The integers in argv[first:], in groups of n; an incomplete last group is dropped.
+ */
+template <int n>
+inline std::vector<std::array<int, n>> bench_args(int argc, char **argv, int first) {
+  std::vector<std::array<int, n>> groups;
+  for (int i = first; i + n - 1 < argc; i += n) {
+    std::array<int, n> g;
+    for (int j = 0; j < n; j++) g[j] = std::atoi(argv[i + j]);
+    groups.push_back(g);
+  }
+  return groups;
+}
+
+/**
+ * @brief GEMM shapes to sweep: the M N K triples in argv[first:], or a default grid of square and
+ * transformer-like shapes (decode, prefill, MLP up/down projections).
+ */
+inline std::vector<std::array<int, 3>> bench_shapes(int argc, char **argv, int first) {
+  std::vector<std::array<int, 3>> shapes = bench_args<3>(argc, argv, first);
+  if (!shapes.empty()) return shapes;
+  for (int s : {1024, 2048, 4096, 8192}) shapes.push_back({s, s, s});
+  for (int m : {16, 128, 4096}) {
+    shapes.push_back({m, 4096, 4096});
+    shapes.push_back({m, 14336, 4096});
+    shapes.push_back({m, 4096, 14336});
+  }
+  return shapes;
+}
+
+/**
+ * @brief Whether the example was started as "<binary> --bench [M N K ...]".
+ */
+inline bool bench_mode(int argc, char **argv) { return argc > 1 && std::strcmp(argv[1], "--bench") == 0; }
+
+/**
+ * @brief The body of an example's --bench mode: calls run(report, dims...) for every shape, then writes
+ * bench_<kernel>.{csv,json}.
+ *
+ * @param shapes[in] Arrays or tuples, unpacked into the arguments of run.
+ * @param run[in] Allocates and fills the inputs for one shape, times the kernel with benchmark(), and adds
+ * the result to report.
+ */
+template <typename Shape, typename F>
+inline int bench_sweep(const std::string &kernel, const std::vector<Shape> &shapes, F &&run) {
+  bench_report report;
+  for (const Shape &shape : shapes) std::apply([&](auto... dims) { run(report, dims...); }, shape);
+  report.write("bench_" + kernel);
+  return 0;
+}
+
+} // namespace kittens
@@ -8,5 +8,7 @@
 #include "algorithms.hpp"
 #include "check.hpp"
 #include "data.hpp"
+#include "npy.hpp"
 #include "kernel_timer.hpp"
+#include "benchmark.hpp"
 #include "util.hpp"
\ No newline at end of file
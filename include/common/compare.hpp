@@ -0,0 +1,245 @@
+/**
+ * @file
+ * @brief One-pass comparison of a result against a reference, on the device or on all host cores.
+ *
+ * Both paths reduce the tensors to a compare_stats summary; the device path transfers nothing else back,
+ * so validating a large output costs one read of each tensor.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+
+#include "check.hpp"
+
+namespace kittens {
+
+/**
+ * @brief Error statistics of actual against expected, mergeable across threads, blocks and chunks.
+ *
+ * An element is an error if its absolute error exceeds epsilon, or if exactly one side is not finite
+ * (or both are, but differ). Relative errors are taken against max(|expected|, 1e-6).
+ */
+struct compare_stats {
+  static constexpr int num_bins = 10; ///< Exactly 0, (0, 1e-7), the decades [1e-7, 1e-6) .. [1e-1, 1), then >= 1.
+  static constexpr int top_k = 8;
+
+  struct worst {
+    uint64_t index;
+    float error, expected, actual;
+  };
+
+  uint64_t count, num_errors, num_nan, num_inf; ///< num_nan / num_inf count non-finite values of actual.
+  uint64_t num_finite;                          ///< Elements where both sides are finite.
+  double sum_abs_error, sum_abs_expected, sum_abs_actual; ///< Over the num_finite elements.
+  float max_abs_error, max_rel_error;
+  uint64_t max_ulp_error;
+  uint64_t histogram[num_bins]; ///< Absolute errors by decade; non-finite mismatches land in the last bin.
+  worst top[top_k];             ///< The largest errors, largest first; ties go to the lower index.
+  int num_top;
+
+  /**
+   * @brief The empty summary. compare_stats is kept trivial so it can live in shared memory.
+   */
+  __host__ __device__ static inline compare_stats zero() {
+    compare_stats s;
+    s.count = s.num_errors = s.num_nan = s.num_inf = s.num_finite = 0;
+    s.sum_abs_error = s.sum_abs_expected = s.sum_abs_actual = 0;
+    s.max_abs_error = s.max_rel_error = 0;
+    s.max_ulp_error = 0;
+    for (int b = 0; b < num_bins; b++) s.histogram[b] = 0;
+    s.num_top = 0;
+    return s;
+  }
+
+  __host__ __device__ inline void insert_worst(const worst &w) {
+    auto before = [](const worst &a, const worst &b) { return a.error > b.error || (a.error == b.error && a.index < b.index); };
+    if (num_top == top_k && !before(w, top[top_k - 1])) return;
+    int j = num_top < top_k ? num_top++ : top_k - 1;
+    for (; j > 0 && before(w, top[j - 1]); j--) top[j] = top[j - 1];
+    top[j] = w;
+  }
+
+  /**
+   * @brief Accounts for element i, given both values in fp32 and their distance in units in the last place
+   * of the stored type.
+   */
+  __host__ __device__ inline void add(uint64_t i, float expected, float actual, uint64_t ulp, float epsilon) {
+    count++;
+    if (std::isnan(actual)) num_nan++;
+    if (std::isinf(actual)) num_inf++;
+    float error;
+    if (std::isfinite(expected) && std::isfinite(actual)) {
+      error = fabsf(expected - actual);
+      num_finite++;
+      sum_abs_error += error;
+      sum_abs_expected += fabsf(expected);
+      sum_abs_actual += fabsf(actual);
+      max_abs_error = fmaxf(max_abs_error, error);
+      max_rel_error = fmaxf(max_rel_error, error / fmaxf(fabsf(expected), 1e-6f));
+      max_ulp_error = ulp > max_ulp_error ? ulp : max_ulp_error;
+    } else {
+      // Matching infinities (or two NaNs) agree; anything else is as wrong as it gets
+      const bool same = (std::isnan(expected) && std::isnan(actual)) || expected == actual;
+      error = same ? 0.f : INFINITY;
+    }
+    const int bin = error == 0.f ? 0 : error >= 1.f ? num_bins - 1 : int(fminf(fmaxf(floorf(log10f(error)) + 9.f, 1.f), float(num_bins - 2)));
+    histogram[bin]++;
+    if (error > epsilon) {
+      num_errors++;
+      insert_worst({i, error, expected, actual});
+    }
+  }
+
+  __host__ __device__ inline void merge(const compare_stats &o) {
+    count += o.count;
+    num_errors += o.num_errors;
+    num_nan += o.num_nan;
+    num_inf += o.num_inf;
+    num_finite += o.num_finite;
+    sum_abs_error += o.sum_abs_error;
+    sum_abs_expected += o.sum_abs_expected;
+    sum_abs_actual += o.sum_abs_actual;
+    max_abs_error = fmaxf(max_abs_error, o.max_abs_error);
+    max_rel_error = fmaxf(max_rel_error, o.max_rel_error);
+    max_ulp_error = o.max_ulp_error > max_ulp_error ? o.max_ulp_error : max_ulp_error;
+    for (int b = 0; b < num_bins; b++) histogram[b] += o.histogram[b];
+    for (int j = 0; j < o.num_top; j++) insert_worst(o.top[j]);
+  }
+
+  inline double mean_abs_error() const { return num_finite ? sum_abs_error / num_finite : 0; }
+  inline bool passed(float acceptable_error_ratio) const { return num_errors <= uint64_t(acceptable_error_ratio * count); }
+
+  /**
+   * @brief Prints the summary, and the worst elements if more than acceptable_error_ratio of them are errors.
+   */
+  inline void print(float acceptable_error_ratio = 0.01, int max_errors_to_print = top_k) const {
+    if (!passed(acceptable_error_ratio)) {
+      for (int j = 0; j < std::min(num_top, max_errors_to_print); j++)
+        std::cout << "Error at index " << top[j].index << ": Expected " << top[j].expected << " != Got " << top[j].actual << std::endl;
+      if (num_errors > uint64_t(std::min(num_top, max_errors_to_print)))
+        std::cout << "... and " << num_errors - std::min(num_top, max_errors_to_print) << " more errors (" << num_errors << " total out of " << count << ")" << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "Mean absolute element from expected: " << (num_finite ? sum_abs_expected / num_finite : 0) << std::endl;
+    std::cout << "Mean absolute element from actual: " << (num_finite ? sum_abs_actual / num_finite : 0) << std::endl;
+    std::cout << "Mean absolute error: " << mean_abs_error() << std::endl;
+    std::cout << "Max absolute error: " << max_abs_error << std::endl;
+    std::cout << "Max relative error: " << max_rel_error << std::endl;
+    std::cout << "Max ULP error: " << max_ulp_error << std::endl;
+    std::cout << "NaN / Inf in actual: " << num_nan << " / " << num_inf << std::endl;
+    std::cout << "Absolute error histogram: 0: " << histogram[0];
+    for (int b = 1; b < num_bins - 1; b++) std::cout << ", <1e" << b - 8 << ": " << histogram[b];
+    std::cout << ", >=1: " << histogram[num_bins - 1] << std::endl;
+    std::cout << "Number of errors: " << num_errors << " (out of " << count << ", " << std::setprecision(2) << (100.0 * num_errors / std::max<uint64_t>(count, 1))
+              << "%)" << std::endl;
+  }
+};
+
+namespace detail {
+/**
+ * @brief x's bits as an integer that is monotonic in x, so that the difference of two is their ULP distance.
+ */
+template <typename T>
+__host__ __device__ inline int64_t ordered_bits(const T &x) {
+  using U = std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, uint32_t>>;
+  static_assert(sizeof(T) == sizeof(U), "ULP distance needs a 1-, 2- or 4-byte type");
+  U u;
+  __builtin_memcpy(&u, &x, sizeof(T));
+  constexpr U sign = U(U(1) << (8 * sizeof(T) - 1));
+  return (u & sign) ? -int64_t(u & U(~sign)) : int64_t(u);
+}
+
+template <typename T>
+__host__ __device__ inline void compare_element(compare_stats &s, uint64_t i, const T &expected, const T &actual, float epsilon) {
+  const int64_t d = ordered_bits(expected) - ordered_bits(actual);
+  s.add(i, base_types::convertor<float, T>::convert(expected), base_types::convertor<float, T>::convert(actual), uint64_t(d < 0 ? -d : d), epsilon);
+}
+} // namespace detail
+
+/**
+ * @brief Compares n host elements on all cores.
+ */
+template <typename T>
+inline compare_stats compare_host(const T *expected, const T *actual, size_t n, float epsilon = 5e-2) {
+  compare_stats total = compare_stats::zero();
+#pragma omp parallel
+  {
+    compare_stats local = compare_stats::zero();
+#pragma omp for schedule(static) nowait
+    for (size_t i = 0; i < n; i++) detail::compare_element(local, i, expected[i], actual[i], epsilon);
+#pragma omp critical
+    total.merge(local);
+  }
+  return total;
+}
+
+#ifndef KITTENS_EMULATOR
+namespace detail {
+constexpr int compare_threads = 256;
+constexpr int compare_slots = 32;
+
+/**
+ * @brief Reduces every thread's local stats into s[0]. Threads fold into compare_slots shared slots a slot
+ * group at a time, and the slots are then merged as a tree, which keeps shared memory small.
+ */
+__device__ inline void reduce_compare_stats(compare_stats *s, const compare_stats &local) {
+  for (int g = 0; g < compare_threads / compare_slots; g++) {
+    if (threadIdx.x / compare_slots == g) {
+      if (g == 0) s[threadIdx.x] = local;
+      else s[threadIdx.x % compare_slots].merge(local);
+    }
+    __syncthreads();
+  }
+  for (int w = compare_slots / 2; w > 0; w /= 2) {
+    if (threadIdx.x < w) s[threadIdx.x].merge(s[threadIdx.x + w]);
+    __syncthreads();
+  }
+}
+
+template <typename T>
+__global__ __launch_bounds__(compare_threads) void compare_ker(const T *expected, const T *actual, size_t n, float epsilon, compare_stats *partials) {
+  __shared__ compare_stats s[compare_slots];
+  compare_stats local = compare_stats::zero();
+  const size_t stride = size_t(gridDim.x) * blockDim.x;
+  for (size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x; i < n; i += stride) compare_element(local, i, expected[i], actual[i], epsilon);
+  reduce_compare_stats(s, local);
+  if (threadIdx.x == 0) partials[blockIdx.x] = s[0];
+}
+
+// Not a template, so it needs internal linkage to be defined in every translation unit that includes this header
+static __global__ __launch_bounds__(compare_threads) void compare_merge_ker(compare_stats *partials, int num_partials) {
+  __shared__ compare_stats s[compare_slots];
+  compare_stats local = compare_stats::zero();
+  for (int i = threadIdx.x; i < num_partials; i += blockDim.x) local.merge(partials[i]);
+  reduce_compare_stats(s, local);
+  if (threadIdx.x == 0) partials[0] = s[0];
+}
+} // namespace detail
+
+/**
+ * @brief Compares n device elements with a reduction kernel; only the summary is copied back.
+ */
+template <typename T>
+inline compare_stats compare_device(const T *expected, const T *actual, size_t n, float epsilon = 5e-2, hipStream_t stream = nullptr) {
+  constexpr int threads = detail::compare_threads;
+  const int blocks = int(std::clamp<size_t>((n + threads - 1) / threads, 1, 1024));
+  compare_stats *partials, result;
+  hipCheck(hipMalloc((void **)&partials, blocks * sizeof(compare_stats)));
+  hipLaunchKernelGGL((detail::compare_ker<T>), dim3(blocks), dim3(threads), 0, stream, expected, actual, n, epsilon, partials);
+  hipCheck(hipGetLastError());
+  hipLaunchKernelGGL(detail::compare_merge_ker, dim3(1), dim3(threads), 0, stream, partials, blocks);
+  hipCheck(hipGetLastError());
+  hipCheck(hipMemcpyAsync(&result, partials, sizeof(compare_stats), hipMemcpyDeviceToHost, stream));
+  hipCheck(hipStreamSynchronize(stream));
+  hipCheck(hipFree(partials));
+  return result;
+}
+#endif
+
+} // namespace kittens
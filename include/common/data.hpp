@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <random>
 #include <utility>
 #include <vector>
@@ -8,6 +10,9 @@
 #include <iomanip>
 #include <sstream>
 
+#include "compare.hpp"
+#include "random.hpp"
+
 static int seed = 0;
 
 namespace kittens {
@@ -41,12 +46,18 @@ template <typename T>
 concept fill_type = std::is_same_v<T, fill_empty> || std::is_same_v<T, fill_random> || std::is_same_v<T, fill_zeros> || std::is_same_v<T, fill_ones>;
 
 template <fill_type fill_type, typename T>
-std::pair<std::vector<T>, T *> init(int N) {
+std::vector<T> init_host(int N) {
   std::vector<T> h_data(N);
   fill_type fill;
   if (fill.has_value())
     for (int i = 0; i < N; i++)
       h_data[i] = base_types::convertor<T, float>::convert(fill.value());
+  return h_data;
+}
+
+template <fill_type fill_type, typename T>
+std::pair<std::vector<T>, T *> init(int N) {
+  std::vector<T> h_data = init_host<fill_type, T>(N);
 
   T *d_data;
   hipCheck(hipMalloc((void **)&d_data, N * sizeof(T)));
@@ -55,6 +66,151 @@ std::pair<std::vector<T>, T *> init(int N) {
   return {h_data, d_data};
 }
 
+/**
+ * @brief A tensor with a pinned host copy and a device copy, both freed when it is destroyed.
+ *
+ * Returned by init_async(); the host side can be indexed and iterated like the std::vector of init(), so
+ * it can be handed to cpu_matmul() and assert_equal() directly.
+ */
+template <typename T>
+class tensor {
+private:
+  T *h_data = nullptr;
+  T *d_data = nullptr;
+  size_t n = 0;
+  hipEvent_t uploaded = nullptr;
+
+public:
+  tensor() = default;
+  inline explicit tensor(size_t n) : n(n) {
+    hipCheck(hipHostMalloc((void **)&h_data, n * sizeof(T)));
+    hipCheck(hipMalloc((void **)&d_data, n * sizeof(T)));
+    hipCheck(hipEventCreate(&uploaded));
+  }
+  tensor(const tensor &) = delete;
+  tensor &operator=(const tensor &) = delete;
+  inline tensor(tensor &&other) noexcept { *this = std::move(other); }
+  inline tensor &operator=(tensor &&other) noexcept {
+    std::swap(h_data, other.h_data);
+    std::swap(d_data, other.d_data);
+    std::swap(n, other.n);
+    std::swap(uploaded, other.uploaded);
+    return *this;
+  }
+  inline ~tensor() {
+    if (uploaded) {
+      // The host buffer may still be the source of an upload
+      hipCheck(hipEventSynchronize(uploaded));
+      hipCheck(hipEventDestroy(uploaded));
+    }
+    if (d_data) hipCheck(hipFree(d_data));
+    if (h_data) hipCheck(hipHostFree(h_data));
+  }
+
+  inline T *host() { return h_data; }
+  inline const T *host() const { return h_data; }
+  inline T *device() { return d_data; }
+  inline T *data() { return h_data; }
+  inline const T *data() const { return h_data; }
+  inline size_t size() const { return n; }
+  inline T &operator[](size_t i) { return h_data[i]; }
+  inline const T &operator[](size_t i) const { return h_data[i]; }
+  inline T *begin() { return h_data; }
+  inline T *end() { return h_data + n; }
+  inline const T *begin() const { return h_data; }
+  inline const T *end() const { return h_data + n; }
+
+  /**
+   * @brief Marks the end of the upload on stream; wait() blocks on it.
+   */
+  inline void record_upload(hipStream_t stream) { hipCheck(hipEventRecord(uploaded, stream)); }
+  /**
+   * @brief Blocks until the upload finished. Kernels on the upload stream need not call this.
+   */
+  inline void wait() const { hipCheck(hipEventSynchronize(uploaded)); }
+};
+
+namespace detail {
+/**
+ * @brief Allocates a tensor, fills it slab by slab and enqueues each slab's upload as soon as it is filled.
+ *
+ * @param slab[in] Elements per slab.
+ * @param fill_slab[in] Called as fill_slab(t, s0, s1) to fill elements [s0, s1) of t on the host.
+ */
+template <typename T, typename F>
+tensor<T> init_async_slabs(size_t N, size_t slab, hipStream_t stream, F &&fill_slab) {
+  tensor<T> t(N);
+  for (size_t s0 = 0; s0 < N; s0 += slab) {
+    const size_t s1 = std::min(N, s0 + slab);
+    fill_slab(t, s0, s1);
+    hipCheck(hipMemcpyAsync(t.device() + s0, t.host() + s0, (s1 - s0) * sizeof(T), hipMemcpyHostToDevice, stream));
+  }
+  t.record_upload(stream);
+  return t;
+}
+} // namespace detail
+
+/**
+ * @brief Like init(), but fills pinned host memory on all cores and uploads it asynchronously.
+ *
+ * The tensor is filled and copied in slabs, so the copy of one slab overlaps the filling of the next, and
+ * the call returns as soon as the last slab is enqueued: the next tensor's generation then overlaps this
+ * one's transfer. fill_random draws from rng::uniform with the next global seed, so the values do not
+ * depend on the thread count (they differ from init()'s, which draws from a single sequence).
+ *
+ * @param N[in] Number of elements.
+ * @param stream[in] Stream to upload on; kernels enqueued on it afterwards see the data.
+ */
+template <fill_type fill_type, typename T>
+tensor<T> init_async(size_t N, hipStream_t stream = nullptr) {
+  const rng::uniform random{uint64_t(seed++)};
+  return detail::init_async_slabs<T>(N, size_t(1) << 24, stream, [&](tensor<T> &t, size_t s0, size_t s1) {
+    if constexpr (std::is_same_v<fill_type, fill_random>) {
+#pragma omp parallel for schedule(static)
+      for (size_t i = s0; i < s1; i++) t[i] = base_types::convertor<T, float>::convert(random(i, 0, 0));
+    } else if constexpr (!std::is_same_v<fill_type, fill_empty>) {
+      const T value = base_types::convertor<T, float>::convert(fill_type{}.value());
+#pragma omp parallel for schedule(static)
+      for (size_t i = s0; i < s1; i++) t[i] = value;
+    }
+  });
+}
+
+/**
+ * @brief A rows x cols matrix drawn from a counter-based distribution, e.g. init<bf16>(M, K, rng::normal{1}).
+ *
+ * Unlike the fill types, the values depend only on the distribution's seed, not on how many tensors were
+ * created before, and they match rng::fill() of the same matrix on the device.
+ */
+template <typename T, rng::distribution D>
+std::pair<std::vector<T>, T *> init(int rows, int cols, const D &d) {
+  const size_t N = size_t(rows) * cols;
+  std::vector<T> h_data(N);
+  rng::fill_host(h_data.data(), N, rows, cols, d);
+
+  T *d_data;
+  hipCheck(hipMalloc((void **)&d_data, N * sizeof(T)));
+  hipCheck(hipMemcpy(d_data, h_data.data(), N * sizeof(T), hipMemcpyHostToDevice));
+
+  return {h_data, d_data};
+}
+
+/**
+ * @brief init_async() of a rows x cols matrix drawn from a counter-based distribution.
+ *
+ * Slabs are whole rows, so structured distributions see their true positions.
+ */
+template <typename T, rng::distribution D>
+tensor<T> init_async(int rows, int cols, const D &d, hipStream_t stream = nullptr) {
+  const size_t slab_rows = std::max<size_t>(1, (size_t(1) << 24) / cols);
+  return detail::init_async_slabs<T>(size_t(rows) * cols, slab_rows * cols, stream, [&](tensor<T> &t, size_t s0, size_t s1) {
+    rng::fill_host_rows(t.host(), s0 / cols, s1 / cols, rows, cols, d);
+  });
+}
+
+/**
+ * @brief Writes tensors as aligned text, for eyeballing small ones; dump anything large with save_npy().
+ */
 template <typename T>
 void print_tensor_to_file(std::string const &filename, std::vector<std::tuple<std::string, T *, int, int>> const &data) {
   std::ofstream file(filename);
@@ -78,53 +234,43 @@ void print_tensor_to_file(std::string const &filename, std::vector<std::tuple<st
   }
 }
 
-template <typename T, typename RH>
-void assert_equal(std::vector<T> const &expected, RH const &actual, float epsilon = 5e-2, float acceptable_error_ratio = 0.01, int max_errors_to_print = 20) {
-  int N = expected.size();
-  int num_errors = 0;
-  int acceptable_errors = static_cast<int>(acceptable_error_ratio * N);
-
-  std::stringstream ss;
-  std::vector<T> diff_between(N);
-  std::vector<double> errors;
-
-  for (int i = 0; i < N; i++) {
-    double error = static_cast<double>(std::abs(base_types::convertor<float, T>::convert(expected[i]) - base_types::convertor<float, T>::convert(actual[i])));
-    if (std::isnan(error)) {
-      error = 10000.0; // force NaNs to show up - otherwise they are ignored
-    }
-    if (error > epsilon) {
-      num_errors++;
-      errors.push_back(error);
-
-      if (num_errors < max_errors_to_print)
-        ss << "Error at index " << i << ": Expected " << base_types::convertor<float, T>::convert(expected[i]) << " != Got " << base_types::convertor<float, T>::convert(actual[i]) << std::endl;
-    }
-  }
-
-  if (num_errors > max_errors_to_print)
-    ss << "... and " << num_errors - max_errors_to_print << " more errors (" << num_errors << " total out of " << N << ")" << std::endl;
-
-  if (num_errors > acceptable_errors) {
-    std::cout << ss.str() << std::endl;
+namespace detail {
+template <typename T>
+void print_comparison(const compare_stats &stats, const T *expected_head, const T *actual_head, float acceptable_error_ratio, int max_errors_to_print) {
+  auto f = [](const T &x) { return base_types::convertor<float, T>::convert(x); };
+  std::cout << "--------------------------------" << std::endl;
+  stats.print(acceptable_error_ratio, max_errors_to_print);
+  if (stats.count >= 3) {
+    std::cout << "Expected[:3]: " << f(expected_head[0]) << ", " << f(expected_head[1]) << ", " << f(expected_head[2]) << std::endl;
+    std::cout << "Got[:3]:      " << f(actual_head[0]) << ", " << f(actual_head[1]) << ", " << f(actual_head[2]) << std::endl;
   }
+  std::cout << "--------------------------------" << std::endl;
+}
+} // namespace detail
 
-  double mean_error = errors.size() > 0 ? std::accumulate(errors.begin(), errors.end(), 0.0) / errors.size() : 0;
-  double min_error = errors.size() > 0 ? *std::min_element(errors.begin(), errors.end()) : 0;
-  double max_error = errors.size() > 0 ? *std::max_element(errors.begin(), errors.end()) : 0;
-
-  double mean_abs_element_from_expected = std::accumulate(expected.begin(), expected.end(), 0.0, [](double acc, T const &val) { return acc + std::abs(base_types::convertor<float, T>::convert(val)); }) / expected.size();
-  double mean_abs_element_from_actual = std::accumulate(actual.begin(), actual.end(), 0.0, [](double acc, T const &val) { return acc + std::abs(base_types::convertor<float, T>::convert(val)); }) / actual.size();
+/**
+ * @brief Compares actual against expected on all cores in one pass (see compare_host()) and prints the summary.
+ *
+ * @param max_errors_to_print[in] Worst elements to list when the check fails; at most compare_stats::top_k.
+ */
+template <typename T, typename RH>
+void assert_equal(std::vector<T> const &expected, RH const &actual, float epsilon = 5e-2, float acceptable_error_ratio = 0.01, int max_errors_to_print = 20) {
+  const compare_stats stats = compare_host(expected.data(), actual.data(), expected.size(), epsilon);
+  detail::print_comparison(stats, expected.data(), actual.data(), acceptable_error_ratio, max_errors_to_print);
+}
 
-  std::cout << "--------------------------------" << std::endl;
-  std::cout << "Mean absolute element from expected: " << std::fixed << std::setprecision(4) << mean_abs_element_from_expected << std::endl;
-  std::cout << "Mean absolute element from actual: " << std::fixed << std::setprecision(4) << mean_abs_element_from_actual << std::endl;
-  std::cout << "Mean absolute error: " << std::fixed << std::setprecision(4) << mean_error << std::endl;
-  std::cout << "Min absolute error: " << std::fixed << std::setprecision(4) << min_error << std::endl;
-  std::cout << "Max absolute error: " << std::fixed << std::setprecision(4) << max_error << std::endl;
-  std::cout << "Number of errors: " << num_errors << " (out of " << N << ", " << std::fixed << std::setprecision(2) << (100.0 * num_errors / N) << "%)" << std::endl;
-  std::cout << "Expected[:3]: " << base_types::convertor<float, T>::convert(expected[0]) << ", " << base_types::convertor<float, T>::convert(expected[1]) << ", " << base_types::convertor<float, T>::convert(expected[2]) << std::endl;
-  std::cout << "Got[:3]:      " << base_types::convertor<float, T>::convert(actual[0]) << ", " << base_types::convertor<float, T>::convert(actual[1]) << ", " << base_types::convertor<float, T>::convert(actual[2]) << std::endl;
-  std::cout << "--------------------------------" << std::endl;
+#ifndef KITTENS_EMULATOR
+/**
+ * @brief assert_equal() of two device buffers, reduced on the device (see compare_device()); only the summary
+ * and the first three elements of each are copied back.
+ */
+template <typename T>
+void assert_equal_device(const T *expected, const T *actual, size_t n, float epsilon = 5e-2, float acceptable_error_ratio = 0.01, int max_errors_to_print = 20) {
+  const compare_stats stats = compare_device(expected, actual, n, epsilon);
+  T expected_head[3], actual_head[3];
+  hipCheck(hipMemcpy(expected_head, expected, std::min<size_t>(n, 3) * sizeof(T), hipMemcpyDeviceToHost));
+  hipCheck(hipMemcpy(actual_head, actual, std::min<size_t>(n, 3) * sizeof(T), hipMemcpyDeviceToHost));
+  detail::print_comparison(stats, expected_head, actual_head, acceptable_error_ratio, max_errors_to_print);
 }
+#endif
 } // namespace kittens
\ No newline at end of file
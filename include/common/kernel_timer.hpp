@@ -1,6 +1,12 @@
 #pragma once
 #include "check.hpp"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <limits>
+#include <map>
 #include <string>
+#include <vector>
 
 namespace kittens {
 class kernel_timer {
@@ -21,7 +27,6 @@ private:
     hipCheck(hipEventRecord(end_event));
     hipCheck(hipEventSynchronize(end_event));
     hipCheck(hipEventElapsedTime(&elapsed_time, start_event, end_event));
-    hipCheck(hipDeviceSynchronize());
     if (should_print)
       std::cout << "[" << name << "]: " << elapsed_time << " ms" << std::endl;
     if (save_time)
@@ -41,4 +46,172 @@ public:
     hipCheck(hipEventDestroy(end_event));
   }
 };
-} // namespace kittens
\ No newline at end of file
+
+/**
+ * @brief Aggregate timings of one named region of a timer_pool, in milliseconds.
+ */
+struct region_stats {
+  int count = 0;
+  double total_ms = 0;
+  float min_ms = std::numeric_limits<float>::infinity();
+  float max_ms = 0;
+  std::vector<float> samples; ///< Every timing, in completion order; only kept if the pool keeps samples.
+
+  inline double mean_ms() const { return count ? total_ms / count : 0; }
+};
+
+/**
+ * @brief Low-overhead GPU timer for named, nestable regions, cheap enough to leave on in production.
+ *
+ * Unlike kernel_timer, nothing here synchronizes when a region ends. Regions record pooled events on one
+ * stream and queue up; poll() folds every region whose end event has completed into its statistics without
+ * blocking, and resolve() waits for the rest. Events are created once and recycled, and only when all of
+ * capacity are in flight does the oldest region get waited on to free its pair.
+ *
+ * A region opened inside another is recorded as "outer/inner".
+ */
+class timer_pool {
+private:
+  struct pending {
+    hipEvent_t start, end;
+    std::string name;
+  };
+
+  hipStream_t stream;
+  int capacity;
+  bool keep_samples;
+  int created = 0;
+  std::vector<hipEvent_t> free_events;
+  std::vector<std::pair<std::string, hipEvent_t>> open;
+  std::deque<pending> in_flight;
+  std::map<std::string, region_stats> regions;
+
+  inline hipEvent_t acquire() {
+    if (free_events.empty()) {
+      if (created < capacity || in_flight.empty()) {
+        hipEvent_t e;
+        hipCheck(hipEventCreate(&e));
+        created++;
+        return e;
+      }
+      // Pool exhausted: wait for the oldest region only
+      hipCheck(hipEventSynchronize(in_flight.front().end));
+      retire_front();
+    }
+    hipEvent_t e = free_events.back();
+    free_events.pop_back();
+    return e;
+  }
+
+  inline void retire_front() {
+    pending &p = in_flight.front();
+    float ms;
+    hipCheck(hipEventElapsedTime(&ms, p.start, p.end));
+    region_stats &r = regions[p.name];
+    r.count++;
+    r.total_ms += ms;
+    r.min_ms = std::min(r.min_ms, ms);
+    r.max_ms = std::max(r.max_ms, ms);
+    if (keep_samples) r.samples.push_back(ms);
+    free_events.push_back(p.start);
+    free_events.push_back(p.end);
+    in_flight.pop_front();
+  }
+
+public:
+  /**
+   * @param stream[in] Stream the events are recorded on; regions time the work enqueued on it.
+   * @param capacity[in] Events kept alive at once, two per region in flight.
+   * @param keep_samples[in] Also keep every individual timing, e.g. for percentiles.
+   */
+  inline explicit timer_pool(hipStream_t stream = nullptr, int capacity = 256, bool keep_samples = false) : stream(stream), capacity(std::max(capacity, 2)), keep_samples(keep_samples) {}
+  timer_pool(const timer_pool &) = delete;
+  timer_pool &operator=(const timer_pool &) = delete;
+
+  inline ~timer_pool() {
+    resolve();
+    for (auto &[name, e] : open) hipCheck(hipEventDestroy(e));
+    for (hipEvent_t e : free_events) hipCheck(hipEventDestroy(e));
+  }
+
+  /**
+   * @brief Opens a region; regions must be closed in reverse order of opening.
+   */
+  inline void begin(const std::string &name) {
+    std::string path = open.empty() ? name : open.back().first + "/" + name;
+    hipEvent_t e = acquire();
+    hipCheck(hipEventRecord(e, stream));
+    open.emplace_back(std::move(path), e);
+  }
+
+  /**
+   * @brief Closes the innermost open region. Does not wait for the GPU.
+   */
+  inline void end() {
+    hipEvent_t e = acquire();
+    hipCheck(hipEventRecord(e, stream));
+    in_flight.push_back({open.back().second, e, std::move(open.back().first)});
+    open.pop_back();
+  }
+
+  /**
+   * @brief Closes the region it opened when it goes out of scope.
+   */
+  class scope {
+  private:
+    timer_pool &pool;
+
+  public:
+    inline scope(timer_pool &pool, const std::string &name) : pool(pool) { pool.begin(name); }
+    scope(const scope &) = delete;
+    inline ~scope() { pool.end(); }
+  };
+  inline scope time(const std::string &name) { return scope(*this, name); }
+
+  /**
+   * @brief Folds every finished region into the statistics, without blocking.
+   *
+   * Regions finish in the order they were closed, since they are all on one stream.
+   */
+  inline void poll() {
+    while (!in_flight.empty()) {
+      hipError_t status = hipEventQuery(in_flight.front().end);
+      if (status == hipErrorNotReady) return;
+      hipCheck(status);
+      retire_front();
+    }
+  }
+
+  /**
+   * @brief Waits for every closed region and folds it into the statistics.
+   */
+  inline void resolve() {
+    if (in_flight.empty()) return;
+    hipCheck(hipEventSynchronize(in_flight.back().end));
+    while (!in_flight.empty()) retire_front();
+  }
+
+  /**
+   * @brief Statistics of every region resolved so far, by path.
+   */
+  inline const std::map<std::string, region_stats> &stats() {
+    poll();
+    return regions;
+  }
+
+  /**
+   * @brief Forgets all statistics; regions still in flight are counted once they resolve.
+   */
+  inline void reset() { regions.clear(); }
+
+  /**
+   * @brief Prints one line per region: count, mean, min and max.
+   */
+  inline void print(std::ostream &os = std::cout) {
+    resolve();
+    for (const auto &[name, r] : regions) {
+      os << "[" << name << "]: " << r.count << " x " << std::setprecision(4) << r.mean_ms() << " ms (min " << r.min_ms << ", max " << r.max_ms << ")" << std::endl;
+    }
+  }
+};
+} // namespace kittens
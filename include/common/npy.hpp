@@ -0,0 +1,256 @@
+/**
+ * @file
+ * @brief Binary tensor dumps in the NumPy .npy format, written in chunks and read back memory-mapped.
+ *
+ * The payload is the raw little-endian elements, so a dump costs one write of the tensor and a reload
+ * costs nothing until the pages are touched. NumPy has no bf16, so bf16 is stored as '<u2'; load it in
+ * Python with np.load(path).view(ml_dtypes.bfloat16).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "base_types.hpp"
+#include "check.hpp"
+
+namespace kittens {
+
+static_assert(std::endian::native == std::endian::little, ".npy payloads are written in host byte order");
+
+/**
+ * @brief The .npy descr of a dumpable element type.
+ */
+template <typename T>
+struct npy_dtype;
+template <>
+struct npy_dtype<float> {
+  static constexpr const char *descr = "<f4";
+};
+template <>
+struct npy_dtype<half> {
+  static constexpr const char *descr = "<f2";
+};
+template <>
+struct npy_dtype<bf16> {
+  static constexpr const char *descr = "<u2";
+};
+
+namespace detail {
+inline size_t npy_numel(const std::vector<size_t> &shape) {
+  size_t n = 1;
+  for (size_t d : shape) n *= d;
+  return n;
+}
+
+/**
+ * @brief A version 1.0 header, padded so the payload starts 64-byte aligned.
+ */
+template <typename T>
+inline std::string npy_header(const std::vector<size_t> &shape) {
+  std::ostringstream dict;
+  dict << "{'descr': '" << npy_dtype<T>::descr << "', 'fortran_order': False, 'shape': (";
+  for (size_t d : shape) dict << d << ", ";
+  dict << "), }";
+  std::string h = dict.str();
+  const size_t unpadded = 10 + h.size() + 1;
+  h.append((64 - unpadded % 64) % 64, ' ');
+  h.push_back('\n');
+  const uint16_t len = uint16_t(h.size());
+  return std::string("\x93NUMPY\x01\x00", 8) + std::string(reinterpret_cast<const char *>(&len), 2) + h;
+}
+} // namespace detail
+
+/**
+ * @brief Streams a tensor to a .npy file in pieces, from host or device memory.
+ *
+ * The header is written up front from the shape, so the elements must then be written in order and add up
+ * to exactly the shape's element count. Device memory goes through two pinned staging buffers: the copy of
+ * one chunk overlaps the disk write of the previous one.
+ */
+template <typename T>
+class npy_writer {
+private:
+  std::ofstream file;
+  std::string path;
+  size_t expected, written = 0;
+  T *staging[2] = {nullptr, nullptr};
+  hipEvent_t copied[2] = {nullptr, nullptr};
+
+public:
+  static constexpr size_t chunk_elements = (size_t(16) << 20) / sizeof(T);
+
+  inline npy_writer(const std::string &path, const std::vector<size_t> &shape) : file(path, std::ios::binary), path(path), expected(detail::npy_numel(shape)) {
+    const std::string header = detail::npy_header<T>(shape);
+    file.write(header.data(), header.size());
+  }
+  npy_writer(const npy_writer &) = delete;
+  npy_writer &operator=(const npy_writer &) = delete;
+  inline ~npy_writer() {
+    for (int b = 0; b < 2; b++) {
+      if (staging[b]) hipCheck(hipHostFree(staging[b]));
+      if (copied[b]) hipCheck(hipEventDestroy(copied[b]));
+    }
+    if (written != expected) std::cerr << path << ": wrote " << written << " of " << expected << " elements" << std::endl;
+  }
+
+  /**
+   * @brief Whether every write so far reached the file.
+   */
+  inline explicit operator bool() const { return bool(file); }
+
+  inline void write(const T *host, size_t n) {
+    file.write(reinterpret_cast<const char *>(host), n * sizeof(T));
+    written += n;
+  }
+
+  /**
+   * @brief Appends n elements of device memory, enqueuing the copies on stream. Returns once they are on disk.
+   */
+  inline void write_device(const T *device, size_t n, hipStream_t stream = nullptr) {
+    if (!staging[0]) {
+      for (int b = 0; b < 2; b++) {
+        hipCheck(hipHostMalloc((void **)&staging[b], chunk_elements * sizeof(T)));
+        hipCheck(hipEventCreate(&copied[b]));
+      }
+    }
+    int prev = -1; // staging buffer holding the previous chunk, written while the next one copies
+    size_t prev_count = 0;
+    for (size_t c0 = 0, chunk = 0; c0 < n; c0 += chunk_elements, chunk++) {
+      const size_t count = std::min(chunk_elements, n - c0);
+      const int b = chunk % 2;
+      hipCheck(hipMemcpyAsync(staging[b], device + c0, count * sizeof(T), hipMemcpyDeviceToHost, stream));
+      hipCheck(hipEventRecord(copied[b], stream));
+      if (prev >= 0) {
+        hipCheck(hipEventSynchronize(copied[prev]));
+        write(staging[prev], prev_count);
+      }
+      prev = b, prev_count = count;
+    }
+    if (prev >= 0) {
+      hipCheck(hipEventSynchronize(copied[prev]));
+      write(staging[prev], prev_count);
+    }
+  }
+};
+
+/**
+ * @brief Dumps a host tensor of the given shape; returns false if the file could not be written.
+ */
+template <typename T>
+inline bool save_npy(const std::string &path, const T *host, const std::vector<size_t> &shape) {
+  npy_writer<T> w(path, shape);
+  w.write(host, detail::npy_numel(shape));
+  return bool(w);
+}
+
+/**
+ * @brief Dumps a device tensor of the given shape through pinned staging buffers.
+ */
+template <typename T>
+inline bool save_npy_device(const std::string &path, const T *device, const std::vector<size_t> &shape, hipStream_t stream = nullptr) {
+  npy_writer<T> w(path, shape);
+  w.write_device(device, detail::npy_numel(shape), stream);
+  return bool(w);
+}
+
+/**
+ * @brief A read-only, memory-mapped view of a C-ordered .npy file of element type T.
+ *
+ * Indexes and iterates like a std::vector, so a golden output can be handed straight to compare_host()
+ * or uploaded with hipMemcpy. Pages are read from disk as they are touched and dropped under memory
+ * pressure, so reloading a large golden tensor costs no copy. An unreadable file, or one of another
+ * element type or in Fortran order, gives an empty view that converts to false.
+ */
+template <typename T>
+class npy_mapping {
+private:
+  void *base = nullptr;
+  size_t bytes = 0;
+  const T *payload = nullptr;
+  size_t n = 0;
+  std::vector<size_t> dims;
+
+  inline bool fail(const std::string &path, const std::string &why) {
+    std::cerr << path << ": " << why << std::endl;
+    return false;
+  }
+
+  inline bool open(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(path, "cannot open");
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      bytes = size_t(st.st_size);
+      base = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (base == MAP_FAILED) base = nullptr;
+    }
+    ::close(fd);
+    if (!base) return fail(path, "cannot map");
+
+    const char *p = static_cast<const char *>(base);
+    if (bytes < 10 || std::memcmp(p, "\x93NUMPY", 6) != 0) return fail(path, "not a .npy file");
+    // Version 1.0 has a 2-byte header length, versions 2.0 and 3.0 a 4-byte one
+    size_t header_len, offset;
+    if (p[6] == 1) {
+      uint16_t len;
+      std::memcpy(&len, p + 8, 2);
+      header_len = len, offset = 10;
+    } else {
+      uint32_t len;
+      std::memcpy(&len, p + 8, 4);
+      header_len = len, offset = 12;
+    }
+    if (offset + header_len > bytes) return fail(path, "truncated header");
+    const std::string header(p + offset, header_len);
+
+    if (header.find(std::string("'descr': '") + npy_dtype<T>::descr + "'") == std::string::npos) return fail(path, "element type is not " + std::string(npy_dtype<T>::descr));
+    if (header.find("'fortran_order': False") == std::string::npos) return fail(path, "Fortran order is not supported");
+    const size_t open_paren = header.find('(', header.find("'shape'"));
+    const size_t close_paren = header.find(')', open_paren);
+    if (open_paren == std::string::npos || close_paren == std::string::npos) return fail(path, "no shape");
+    std::istringstream shape(header.substr(open_paren + 1, close_paren - open_paren - 1));
+    for (std::string d; std::getline(shape, d, ',');)
+      if (d.find_first_of("0123456789") != std::string::npos) dims.push_back(std::stoull(d));
+
+    n = detail::npy_numel(dims);
+    if (offset + header_len + n * sizeof(T) > bytes) return fail(path, "truncated payload");
+    payload = reinterpret_cast<const T *>(p + offset + header_len);
+    return true;
+  }
+
+public:
+  inline explicit npy_mapping(const std::string &path) {
+    if (!open(path)) {
+      if (base) munmap(base, bytes);
+      base = nullptr, payload = nullptr, n = 0;
+      dims.clear();
+    }
+  }
+  npy_mapping(const npy_mapping &) = delete;
+  npy_mapping &operator=(const npy_mapping &) = delete;
+  inline ~npy_mapping() {
+    if (base) munmap(base, bytes);
+  }
+
+  inline explicit operator bool() const { return payload != nullptr; }
+  inline const std::vector<size_t> &shape() const { return dims; }
+  inline const T *data() const { return payload; }
+  inline size_t size() const { return n; }
+  inline const T &operator[](size_t i) const { return payload[i]; }
+  inline const T *begin() const { return payload; }
+  inline const T *end() const { return payload + n; }
+};
+
+} // namespace kittens
@@ -0,0 +1,211 @@
+/**
+ * @file
+ * @brief Counter-based random fills, on the host and on the device.
+ *
+ * Every value is a pure function of (seed, element index), computed with Philox4x32-10, so a tensor
+ * comes out the same whether it is filled by one thread, all cores or a GPU kernel, and adding a tensor
+ * elsewhere in a test does not change this one's inputs.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+
+#include "check.hpp"
+
+namespace kittens {
+namespace rng {
+
+/* ----------  PHILOX4x32-10  ---------- */
+
+/**
+ * @brief The four 32-bit words of one Philox output block.
+ */
+struct philox_block {
+  uint32_t x[4];
+};
+
+/**
+ * @brief Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * @param counter[in] Element index; the low and high halves are the first two counter words.
+ * @param stream[in] Independent sub-sequence of the same seed; the last two counter words.
+ * @param seed[in] The 64-bit key.
+ */
+__host__ __device__ inline philox_block philox(uint64_t counter, uint64_t stream, uint64_t seed) {
+  uint32_t c0 = uint32_t(counter), c1 = uint32_t(counter >> 32), c2 = uint32_t(stream), c3 = uint32_t(stream >> 32);
+  uint32_t k0 = uint32_t(seed), k1 = uint32_t(seed >> 32);
+#pragma unroll
+  for (int round = 0; round < 10; round++) {
+    const uint64_t p0 = uint64_t(0xD2511F53u) * c0;
+    const uint64_t p1 = uint64_t(0xCD9E8D57u) * c2;
+    const uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+    const uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+    c1 = uint32_t(p1);
+    c3 = uint32_t(p0);
+    c0 = n0;
+    c2 = n2;
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+  return {{c0, c1, c2, c3}};
+}
+
+/**
+ * @brief The top 24 bits of x as a float in [0, 1), exactly representable.
+ */
+__host__ __device__ inline float to_unit(uint32_t x) { return float(x >> 8) * (1.f / 16777216.f); }
+
+/* ----------  DISTRIBUTIONS  ---------- */
+
+/**
+ * @brief A distribution gives the value of element (row, col) of a matrix, whose flat index is i.
+ *
+ * Random distributions draw from the counter i, structured ones also look at the position; either way
+ * the value depends on nothing else, which is what lets fill_host() and fill_device() agree.
+ */
+template <typename D>
+concept distribution = requires(const D &d, uint64_t i, int row, int col) {
+  { d(i, row, col) } -> std::convertible_to<float>;
+};
+
+/**
+ * @brief Uniform in [lo, hi); the default range matches fill_random.
+ */
+struct uniform {
+  uint64_t seed;
+  float lo = -1, hi = 1;
+  __host__ __device__ inline float operator()(uint64_t i, int, int) const { return lo + (hi - lo) * to_unit(philox(i, 0, seed).x[0]); }
+};
+
+/**
+ * @brief Normal, by Box-Muller on the first two words of the block.
+ */
+struct normal {
+  uint64_t seed;
+  float mean = 0, stddev = 1;
+  __host__ __device__ inline float operator()(uint64_t i, int, int) const {
+    const philox_block b = philox(i, 0, seed);
+    const float u1 = 1.f - to_unit(b.x[0]); // (0, 1], so the log is finite
+    const float u2 = to_unit(b.x[1]);
+    return mean + stddev * sqrtf(-2.f * logf(u1)) * cosf(6.28318530718f * u2);
+  }
+};
+
+/**
+ * @brief scale on the diagonal, zero elsewhere; rectangular matrices get the leading diagonal.
+ */
+struct identity {
+  float scale = 1;
+  __host__ __device__ inline float operator()(uint64_t, int row, int col) const { return row == col ? scale : 0.f; }
+};
+
+/**
+ * @brief Uniform in [-1, 1) within lower diagonals below and upper diagonals above the main one, zero
+ * outside. Exercises kernels whose tiles are partly or entirely zero.
+ */
+struct banded {
+  uint64_t seed;
+  int lower = 0, upper = 0;
+  __host__ __device__ inline float operator()(uint64_t i, int row, int col) const {
+    if (col < row - lower || col > row + upper) return 0.f;
+    return uniform{seed}(i, row, col);
+  }
+};
+
+/**
+ * @brief A rank-r matrix U * V^T / sqrt(r) with standard normal U and V, so elements are roughly standard
+ * normal too. Each element is a dot product of r values regenerated from (row, k) and (col, k), so nothing
+ * is stored and the cost is r Philox blocks per element; keep r small.
+ */
+struct low_rank {
+  uint64_t seed;
+  int rank = 1;
+  __host__ __device__ inline float operator()(uint64_t, int row, int col) const {
+    float acc = 0;
+    for (int k = 0; k < rank; k++) {
+      // U and V come from their own sub-streams, so U[i, k] and V[i, k] are independent
+      const philox_block u = philox(uint64_t(row) * rank + k, 1, seed);
+      const philox_block v = philox(uint64_t(col) * rank + k, 2, seed);
+      const float un = sqrtf(-2.f * logf(1.f - to_unit(u.x[0]))) * cosf(6.28318530718f * to_unit(u.x[1]));
+      const float vn = sqrtf(-2.f * logf(1.f - to_unit(v.x[0]))) * cosf(6.28318530718f * to_unit(v.x[1]));
+      acc += un * vn;
+    }
+    return acc / sqrtf(float(rank));
+  }
+};
+
+/* ----------  FILLS  ---------- */
+
+/**
+ * @brief Fills rows [r0, r1) of a stack of rows x cols matrices on all cores.
+ *
+ * @param data[out] Host buffer holding the whole stack; only the given rows are written.
+ * @param r0[in] First row to fill, counted across the stack.
+ * @param r1[in] One past the last row to fill.
+ * @param rows[in] Rows per matrix; structured distributions restart at every multiple of rows.
+ * @param cols[in] Columns per matrix.
+ */
+template <typename T, distribution D>
+inline void fill_host_rows(T *data, size_t r0, size_t r1, int rows, int cols, const D &d) {
+#pragma omp parallel for schedule(static)
+  for (size_t r = r0; r < r1; r++) {
+    const int row = int(r % rows);
+    for (int col = 0; col < cols; col++) {
+      const size_t i = r * cols + col;
+      data[i] = base_types::convertor<T, float>::convert(d(i, row, col));
+    }
+  }
+}
+
+/**
+ * @brief Fills n elements, as a stack of rows x cols matrices, on all cores.
+ *
+ * @param n[in] Number of elements; a multiple of cols.
+ */
+template <typename T, distribution D>
+inline void fill_host(T *data, size_t n, int rows, int cols, const D &d) {
+  fill_host_rows(data, 0, n / cols, rows, cols, d);
+}
+
+#ifndef KITTENS_EMULATOR
+template <typename T, distribution D>
+__global__ void fill_ker(T *data, size_t n, int rows, int cols, D d) {
+  const size_t stride = size_t(gridDim.x) * blockDim.x;
+  for (size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x; i < n; i += stride) {
+    const int col = int(i % cols);
+    const int row = int((i / cols) % rows);
+    data[i] = base_types::convertor<T, float>::convert(d(i, row, col));
+  }
+}
+
+/**
+ * @brief fill_host() straight into device memory, with a grid-stride kernel on stream. Produces the same
+ * values as fill_host() for the same arguments.
+ */
+template <typename T, distribution D>
+inline void fill_device(T *data, size_t n, int rows, int cols, const D &d, hipStream_t stream = nullptr) {
+  constexpr int threads = 256;
+  // Capped so that huge tensors loop inside the kernel instead of launching millions of blocks
+  const size_t blocks = std::min<size_t>((n + threads - 1) / threads, size_t(1) << 16);
+  if (blocks == 0) return;
+  hipLaunchKernelGGL((fill_ker<T, D>), dim3(unsigned(blocks)), dim3(threads), 0, stream, data, n, rows, cols, d);
+  hipCheck(hipGetLastError());
+}
+
+/**
+ * @brief Fills every element of a global layout on the device; each (batch, depth) slice is a rows x cols
+ * matrix for the structured distributions.
+ */
+template <typename GL, distribution D>
+inline void fill(const GL &g, const D &d, hipStream_t stream = nullptr) {
+  const size_t n = size_t(g.batch()) * g.depth() * g.rows() * g.cols();
+  fill_device(g.raw_ptr, n, g.rows(), g.cols(), d, stream);
+}
+#endif
+
+} // namespace rng
+} // namespace kittens
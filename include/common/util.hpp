@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <bit>
 #include <concepts>
 #include <memory>
 #include <stdint.h>
@@ -23,6 +24,24 @@ namespace kittens {
  * @brief Constant representing number of threads in a warp.
  */
 constexpr int WAVE_THREADS{64};
+
+#ifdef KITTENS_EMULATOR
+/**
+ * @namespace emulator
+ *
+ * @brief Host-side wavefront emulator. See include/emulator/emulator.hpp.
+ */
+namespace emulator {
+/**
+ * @brief The lane and wave the calling host thread is currently emulating.
+ */
+inline thread_local int current_lane = 0;
+inline thread_local int current_wave = 0;
+} // namespace emulator
+
+__host__ __device__ __forceinline__ int waveid() { return emulator::current_wave; }
+__host__ __device__ __forceinline__ int laneid() { return emulator::current_lane; }
+#else
 /**
 
  * @brief Get the warp ID of the current thread.
@@ -34,6 +53,7 @@ __device__ __forceinline__ int waveid() { return threadIdx.x / WAVE_THREADS; }
  * @return The lane ID.
  */
 __device__ __forceinline__ int laneid() { return threadIdx.x % WAVE_THREADS; }
+#endif
 
 #ifdef KITTENS_MI355X
 constexpr int MAX_SHARED_MEMORY = 163840; // 160KB for CDNA 4
@@ -79,6 +99,62 @@ struct default_type {};
  */
 static constexpr uint32_t MASK_ALL = 0xFFFFFFFF;
 
+/**
+ * @brief The lane whose value butterfly<step>() hands to lane.
+ *
+ * It is always in the other half of lane's aligned group of 2 * step lanes, which is all an all-reduce needs
+ * once every group of step lanes agrees. Steps 4 and 8 mirror the group rather than xor-ing the lane id,
+ * because those are the patterns DPP can do without leaving the row of 16 lanes.
+ *
+ * @tparam step 1, 2, 4, 8, 16 or 32.
+ */
+template <int step>
+__host__ __device__ inline constexpr int butterfly_lane(int lane) {
+  static_assert(step == 1 || step == 2 || step == 4 || step == 8 || step == 16 || step == 32, "step must be a power of two below the wave size");
+  if constexpr (step == 4) return (lane & ~7) | (7 - (lane & 7));    // row_half_mirror
+  else if constexpr (step == 8) return (lane & ~15) | (15 - (lane & 15)); // row_mirror
+  else return lane ^ step;
+}
+
+#ifndef KITTENS_EMULATOR
+/**
+ * @brief Reads a 32-bit word from lane butterfly_lane<step>(laneid()).
+ *
+ * Steps up to 8 stay within a row of 16 lanes and are DPP moves, step 16 is a ds_swizzle within each
+ * half-wave, and only step 32 goes through ds_bpermute. None of them allocate or touch LDS memory.
+ */
+template <int step>
+__device__ inline int butterfly_word(int word) {
+  if constexpr (step == 1) return __builtin_amdgcn_mov_dpp(word, 0xB1, 0xF, 0xF, false); // quad_perm [1, 0, 3, 2]
+  else if constexpr (step == 2) return __builtin_amdgcn_mov_dpp(word, 0x4E, 0xF, 0xF, false); // quad_perm [2, 3, 0, 1]
+  else if constexpr (step == 4) return __builtin_amdgcn_mov_dpp(word, 0x141, 0xF, 0xF, false); // row_half_mirror
+  else if constexpr (step == 8) return __builtin_amdgcn_mov_dpp(word, 0x140, 0xF, 0xF, false); // row_mirror
+  else if constexpr (step == 16) return __builtin_amdgcn_ds_swizzle(word, 0x401F); // bitmask mode, xor 16
+  else return __shfl_xor(word, 32);
+}
+/**
+ * @brief Returns the value x holds in lane butterfly_lane<step>(laneid()).
+ *
+ * @tparam T Any 2-, 4- or 8-byte type, moved as 32-bit words.
+ */
+template <int step, typename T>
+__device__ inline T butterfly(const T &x) {
+  static_assert(sizeof(T) == 2 || sizeof(T) % 4 == 0, "butterfly moves 16-bit values or whole 32-bit words");
+  if constexpr (sizeof(T) == 2) {
+    return std::bit_cast<T>(uint16_t(butterfly_word<step>(std::bit_cast<uint16_t>(x))));
+  } else {
+    struct words {
+      int w[sizeof(T) / 4];
+    } v = std::bit_cast<words>(x);
+#pragma unroll
+    for (int i = 0; i < int(sizeof(T) / 4); i++) {
+      v.w[i] = butterfly_word<step>(v.w[i]);
+    }
+    return std::bit_cast<T>(v);
+  }
+}
+#endif
+
 // Joyously stolen from https://github.com/NVIDIA/cutlass/blob/5c447dd84f8ae0e1d48ff9a2eae26ce8c4958101/include/cute/container/alignment.hpp#L51
 #define KITTENS_ALIGN_AS(n) alignas(n)
 
@@ -176,4 +252,102 @@ struct coord_mnk {
   }
 };
 
+/* ----------  TILE RASTERIZATION  ---------- */
+
+/**
+ * @brief Orders in which a grid can walk the output tiles of a GEMM-like kernel.
+ *
+ * Blocks that run at the same time should share A row panels and B column panels, so these stay in L2
+ * while they are reused. row_major walks whole rows of tiles, streaming every B panel per row;
+ * grouped_m walks columns within bands of `group` tile rows; morton and hilbert walk `group` x `group`
+ * squares of tiles along a space-filling curve, with hilbert never jumping between non-adjacent tiles.
+ */
+enum class raster_order {
+  row_major,
+  grouped_m,
+  morton,
+  hilbert,
+};
+
+namespace detail {
+/**
+ * @brief Gathers the even bits of x into its low half.
+ */
+__host__ __device__ inline int compact_even_bits(int x) {
+  x &= 0x55555555;
+  x = (x | (x >> 1)) & 0x33333333;
+  x = (x | (x >> 2)) & 0x0f0f0f0f;
+  x = (x | (x >> 4)) & 0x00ff00ff;
+  x = (x | (x >> 8)) & 0x0000ffff;
+  return x;
+}
+
+/**
+ * @brief Position of the d-th cell along the Hilbert curve through a side x side square (side a power of two).
+ */
+__host__ __device__ inline void hilbert_d2xy(int side, int d, int &row, int &col) {
+  row = 0;
+  col = 0;
+  for (int s = 1; s < side; s *= 2) {
+    const int rx = 1 & (d / 2);
+    const int ry = 1 & (d ^ rx);
+    if (ry == 0) {
+      if (rx == 1) {
+        row = s - 1 - row;
+        col = s - 1 - col;
+      }
+      const int t = row;
+      row = col;
+      col = t;
+    }
+    col += s * rx;
+    row += s * ry;
+    d /= 4;
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Maps a linear block index to the output tile it should compute.
+ *
+ * Every order is a bijection over [0, tiles_m * tiles_n), so a grid of exactly that many blocks (or a
+ * persistent loop over that many tile indices) covers every tile once.
+ *
+ * @param tile_id[in] Linear index of the tile in processing order, e.g. the flattened block index.
+ * @param tiles_m[in] Number of tiles along M.
+ * @param tiles_n[in] Number of tiles along N.
+ * @param order[in] Walk to follow.
+ * @param group[in] Band height for grouped_m; side of the curve squares for morton and hilbert, where it
+ *        must be a power of two. Squares cut by the edge of the grid are walked row-major.
+ * @return The tile, with k = 0.
+ */
+__host__ __device__ inline coord_mnk rasterize(int tile_id, int tiles_m, int tiles_n, raster_order order, int group = 8) {
+  if (order == raster_order::row_major) {
+    return {tile_id / tiles_n, tile_id % tiles_n, 0};
+  }
+  // Bands of `group` tile rows, the last possibly shorter
+  const int band = tile_id / (group * tiles_n);
+  const int band_m = band * group;
+  const int band_height = tiles_m - band_m < group ? tiles_m - band_m : group;
+  const int in_band = tile_id - band * group * tiles_n;
+  if (order == raster_order::grouped_m) {
+    return {band_m + in_band % band_height, in_band / band_height, 0};
+  }
+  // Squares of `group` x `group` tiles along the band, the last possibly narrower
+  const int square_n = in_band / (band_height * group) * group;
+  const int square_width = tiles_n - square_n < group ? tiles_n - square_n : group;
+  const int in_square = in_band % (band_height * group);
+  if (band_height != group || square_width != group) {
+    return {band_m + in_square / square_width, square_n + in_square % square_width, 0};
+  }
+  int row, col;
+  if (order == raster_order::morton) {
+    row = detail::compact_even_bits(in_square >> 1);
+    col = detail::compact_even_bits(in_square);
+  } else {
+    detail::hilbert_d2xy(group, in_square, row, col);
+  }
+  return {band_m + row, square_n + col, 0};
+}
+
 } // namespace kittens
\ No newline at end of file
@@ -0,0 +1,403 @@
+/**
+ * @file
+ * @brief Lazy, memory-mapped loading of safetensors checkpoints into global layouts.
+ *
+ * Opening a checkpoint maps the file and parses its header, nothing more; each tensor is read from disk
+ * and uploaded the first time it is asked for, so startup cost does not grow with the checkpoint.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "base_types.hpp"
+#include "check.hpp"
+#include "../types/global/global.hpp"
+
+namespace kittens {
+
+/**
+ * @brief The safetensors dtype of a loadable element type.
+ */
+template <typename T>
+struct safetensors_dtype;
+template <>
+struct safetensors_dtype<float> {
+  static constexpr const char *name = "F32";
+};
+template <>
+struct safetensors_dtype<half> {
+  static constexpr const char *name = "F16";
+};
+template <>
+struct safetensors_dtype<bf16> {
+  static constexpr const char *name = "BF16";
+};
+
+/**
+ * @brief Where a loaded tensor lives.
+ */
+enum class weight_residency {
+  device, ///< Copied into its own device buffer; what kernels in the hot path should read.
+  mapped, ///< Left in the file mapping and read by kernels over the bus; no device memory, no copy.
+};
+
+namespace detail {
+/**
+ * @brief Just enough JSON for a safetensors header: objects, arrays, strings and integers.
+ */
+struct json_cursor {
+  const char *p, *end;
+
+  inline void fail(const char *what) const { throw std::runtime_error(std::string("Malformed safetensors header: ") + what); }
+  inline void skip_ws() {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+  }
+  inline bool consume(char c) {
+    skip_ws();
+    if (p < end && *p == c) return ++p, true;
+    return false;
+  }
+  inline void expect(char c) {
+    if (!consume(c)) fail("unexpected character");
+  }
+  inline std::string string() {
+    expect('"');
+    std::string s;
+    while (p < end && *p != '"') {
+      if (*p == '\\' && p + 1 < end) p++; // names are plain ASCII; keep escaped characters verbatim
+      s.push_back(*p++);
+    }
+    expect('"');
+    return s;
+  }
+  inline size_t integer() {
+    skip_ws();
+    if (p == end || *p < '0' || *p > '9') fail("expected an integer");
+    size_t v = 0;
+    while (p < end && *p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+    return v;
+  }
+  inline std::vector<size_t> integers() {
+    std::vector<size_t> v;
+    expect('[');
+    if (consume(']')) return v;
+    do v.push_back(integer());
+    while (consume(','));
+    expect(']');
+    return v;
+  }
+  /**
+   * @brief Skips any value, e.g. the __metadata__ object.
+   */
+  inline void skip() {
+    skip_ws();
+    if (p < end && *p == '"') {
+      string();
+    } else if (consume('{')) {
+      if (consume('}')) return;
+      do {
+        string();
+        expect(':');
+        skip();
+      } while (consume(','));
+      expect('}');
+    } else if (consume('[')) {
+      if (consume(']')) return;
+      do skip();
+      while (consume(','));
+      expect(']');
+    } else {
+      while (p < end && *p != ',' && *p != '}' && *p != ']') p++;
+    }
+  }
+};
+} // namespace detail
+
+/**
+ * @brief A host tensor to write with save_safetensors().
+ */
+struct safetensors_entry {
+  std::string name, dtype;
+  std::vector<size_t> shape;
+  const void *data;
+  size_t bytes;
+
+  template <typename T>
+  static inline safetensors_entry of(const std::string &name, const T *data, const std::vector<size_t> &shape) {
+    size_t numel = 1;
+    for (size_t d : shape) numel *= d;
+    return {name, safetensors_dtype<T>::name, shape, data, numel * sizeof(T)};
+  }
+};
+
+/**
+ * @brief Writes host tensors as a safetensors checkpoint, back to back in the given order; returns false if
+ * the file could not be written. Meant for tests and small checkpoints: everything is written in one pass.
+ */
+inline bool save_safetensors(const std::string &path, const std::vector<safetensors_entry> &tensors) {
+  std::string header = "{";
+  size_t offset = 0;
+  for (const auto &t : tensors) {
+    header += (header.size() > 1 ? ", \"" : "\"") + t.name + "\": {\"dtype\": \"" + t.dtype + "\", \"shape\": [";
+    for (size_t i = 0; i < t.shape.size(); i++) header += (i ? ", " : "") + std::to_string(t.shape[i]);
+    header += "], \"data_offsets\": [" + std::to_string(offset) + ", " + std::to_string(offset + t.bytes) + "]}";
+    offset += t.bytes;
+  }
+  header += "}";
+  header.append((8 - header.size() % 8) % 8, ' '); // keeps the payload 8-byte aligned
+  const uint64_t header_len = header.size();
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char *>(&header_len), 8);
+  file.write(header.data(), header.size());
+  for (const auto &t : tensors) file.write(static_cast<const char *>(t.data), t.bytes);
+  return bool(file);
+}
+
+/**
+ * @brief A safetensors checkpoint, mapped read-only, whose tensors are uploaded on first use.
+ *
+ * A device-resident tensor is copied straight out of the mapping: the mapped range is page-locked with
+ * hipHostRegister so the DMA engine reads the page cache directly, and unregistered once the copy lands.
+ * Where registration is refused (read-only mappings on older ROCm, or a page already registered for a
+ * neighbouring tensor still in flight), the tensor is copied through two pinned staging buffers instead,
+ * reading one chunk from the file while the previous one uploads.
+ *
+ * Copies are asynchronous on the stream given to get(): kernels on that stream can use the tensor right
+ * away, other streams must synchronize() first. Errors (missing file or tensor, wrong dtype or shape)
+ * throw std::runtime_error, like make_gl().
+ */
+class weight_loader {
+private:
+  struct entry {
+    std::string dtype;
+    std::vector<size_t> shape;
+    size_t begin, end; // byte offsets into the payload
+    void *device = nullptr;
+    bool owns_device = false;  // device is a hipMalloc'd copy, not the mapping's device alias
+    bool registered = false;   // the mapped range is registered with HIP
+    hipEvent_t done = nullptr; // the upload out of a registered range
+  };
+
+  static constexpr size_t staging_bytes = size_t(64) << 20;
+
+  std::string path;
+  void *base = nullptr;
+  size_t bytes = 0;
+  const char *payload = nullptr;
+  std::map<std::string, entry> entries;
+  void *staging[2] = {nullptr, nullptr};
+  hipEvent_t staged[2] = {nullptr, nullptr};
+  int next_staging = 0;
+
+  inline void *host(const entry &e) const { return const_cast<char *>(payload + e.begin); }
+
+  /**
+   * @brief Unregisters the ranges whose uploads have finished, so their pages can be evicted again.
+   */
+  inline void reap(bool wait) {
+    for (auto &[name, e] : entries) {
+      if (!e.done) continue;
+      if (wait) {
+        hipCheck(hipEventSynchronize(e.done));
+      } else if (hipEventQuery(e.done) != hipSuccess) {
+        continue;
+      }
+      hipCheck(hipEventDestroy(e.done));
+      hipCheck(hipHostUnregister(host(e)));
+      e.done = nullptr;
+      e.registered = false;
+    }
+  }
+
+  inline bool try_register(const entry &e, unsigned flags) {
+    if (hipHostRegister(host(e), e.end - e.begin, flags | hipHostRegisterReadOnly) == hipSuccess) return true;
+    (void)hipGetLastError(); // the staged path below handles it; do not leave the error for the next check
+    return false;
+  }
+
+  inline void upload_staged(entry &e, hipStream_t stream) {
+    if (!staging[0]) {
+      for (int b = 0; b < 2; b++) {
+        hipCheck(hipHostMalloc(&staging[b], staging_bytes));
+        hipCheck(hipEventCreateWithFlags(&staged[b], hipEventDisableTiming));
+        hipCheck(hipEventRecord(staged[b], stream));
+      }
+    }
+    const size_t n = e.end - e.begin;
+    for (size_t c0 = 0; c0 < n; c0 += staging_bytes) {
+      const size_t count = std::min(staging_bytes, n - c0);
+      const int b = next_staging;
+      next_staging ^= 1;
+      // The buffer's previous upload must be done before it is refilled; the fill overlaps the other's upload
+      hipCheck(hipEventSynchronize(staged[b]));
+      std::memcpy(staging[b], payload + e.begin + c0, count);
+      hipCheck(hipMemcpyAsync(static_cast<char *>(e.device) + c0, staging[b], count, hipMemcpyHostToDevice, stream));
+      hipCheck(hipEventRecord(staged[b], stream));
+    }
+  }
+
+  inline void materialize(entry &e, weight_residency residency, hipStream_t stream) {
+    const size_t n = e.end - e.begin;
+    // Start reading the tensor's pages ahead of the copy; offsets are rounded out to whole pages
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    const uintptr_t first = reinterpret_cast<uintptr_t>(host(e)) & ~(page - 1);
+    madvise(reinterpret_cast<void *>(first), reinterpret_cast<uintptr_t>(host(e)) + n - first, MADV_WILLNEED);
+
+    if (residency == weight_residency::mapped && try_register(e, hipHostRegisterMapped)) {
+      e.registered = true;
+      hipCheck(hipHostGetDevicePointer(&e.device, host(e), 0));
+      return;
+    }
+    hipCheck(hipMalloc(&e.device, n));
+    e.owns_device = true;
+    if (try_register(e, hipHostRegisterDefault)) {
+      e.registered = true;
+      hipCheck(hipMemcpyAsync(e.device, host(e), n, hipMemcpyHostToDevice, stream));
+      hipCheck(hipEventCreateWithFlags(&e.done, hipEventDisableTiming));
+      hipCheck(hipEventRecord(e.done, stream));
+    } else {
+      upload_staged(e, stream);
+    }
+  }
+
+  /**
+   * @brief Reads the JSON tensor table that follows the 8-byte header length.
+   */
+  inline void parse() {
+    const char *p = static_cast<const char *>(base);
+    uint64_t header_len;
+    std::memcpy(&header_len, p, 8);
+    // The constructor ensures bytes >= 8; comparing against the remainder keeps a huge header_len from wrapping
+    if (header_len > bytes - 8) throw std::runtime_error(path + " is not a safetensors file");
+    payload = p + 8 + header_len;
+    const size_t payload_bytes = bytes - 8 - header_len;
+
+    detail::json_cursor json{p + 8, payload};
+    json.expect('{');
+    if (!json.consume('}')) {
+      do {
+        const std::string name = json.string();
+        json.expect(':');
+        if (name == "__metadata__") {
+          json.skip();
+          continue;
+        }
+        entry e;
+        std::vector<size_t> offsets;
+        json.expect('{');
+        do {
+          const std::string key = json.string();
+          json.expect(':');
+          if (key == "dtype") e.dtype = json.string();
+          else if (key == "shape") e.shape = json.integers();
+          else if (key == "data_offsets") offsets = json.integers();
+          else json.skip();
+        } while (json.consume(','));
+        json.expect('}');
+        if (offsets.size() != 2 || offsets[0] > offsets[1] || offsets[1] > payload_bytes) throw std::runtime_error("Bad data_offsets for " + name + " in " + path);
+        e.begin = offsets[0];
+        e.end = offsets[1];
+        entries.emplace(name, std::move(e));
+      } while (json.consume(','));
+      json.expect('}');
+    }
+  }
+
+public:
+  /**
+   * @brief Maps the checkpoint at path and reads its tensor table; no tensor data is read.
+   */
+  inline explicit weight_loader(std::string path) : path(std::move(path)) {
+    const int fd = ::open(this->path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open " + this->path);
+    struct stat st;
+    if (fstat(fd, &st) == 0) bytes = size_t(st.st_size);
+    if (bytes >= 8) base = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (!base || base == MAP_FAILED) throw std::runtime_error("Cannot map " + this->path);
+
+    try {
+      parse();
+    } catch (...) {
+      munmap(base, bytes);
+      throw;
+    }
+  }
+  weight_loader(const weight_loader &) = delete;
+  weight_loader &operator=(const weight_loader &) = delete;
+  inline ~weight_loader() {
+    synchronize();
+    for (auto &[name, e] : entries) {
+      if (e.owns_device) hipCheck(hipFree(e.device));
+      if (e.registered) hipCheck(hipHostUnregister(host(e)));
+    }
+    for (int b = 0; b < 2; b++) {
+      if (staging[b]) hipCheck(hipHostFree(staging[b]));
+      if (staged[b]) hipCheck(hipEventDestroy(staged[b]));
+    }
+    munmap(base, bytes);
+  }
+
+  inline bool contains(const std::string &name) const { return entries.count(name) != 0; }
+  inline std::vector<std::string> names() const {
+    std::vector<std::string> v;
+    for (const auto &[name, e] : entries) v.push_back(name);
+    return v;
+  }
+  inline const std::vector<size_t> &shape(const std::string &name) const {
+    auto it = entries.find(name);
+    if (it == entries.end()) throw std::runtime_error("No tensor " + name + " in " + path);
+    return it->second.shape;
+  }
+
+  /**
+   * @brief A global layout over the named tensor, uploading it first if this is its first use.
+   *
+   * The tensor's shape is right-aligned onto (batch, depth, rows, cols), so a 2-D weight becomes 1 x 1 x
+   * rows x cols. The residency is fixed by the first get() of a tensor.
+   */
+  template <ducks::gl::all GL>
+  inline GL get(const std::string &name, weight_residency residency = weight_residency::device, hipStream_t stream = nullptr) {
+    reap(false);
+    auto it = entries.find(name);
+    if (it == entries.end()) throw std::runtime_error("No tensor " + name + " in " + path);
+    entry &e = it->second;
+    if (e.dtype != safetensors_dtype<typename GL::dtype>::name) throw std::runtime_error(name + " is " + e.dtype + ", not " + safetensors_dtype<typename GL::dtype>::name);
+    if (e.shape.size() > 4) throw std::runtime_error(name + " has more than 4 dimensions");
+    int dims[4] = {1, 1, 1, 1};
+    size_t numel = 1;
+    bool overflow = false;
+    for (size_t i = 0; i < e.shape.size(); i++) {
+      if (e.shape[i] > size_t(std::numeric_limits<int>::max())) throw std::runtime_error(name + " has a dimension too large for a global layout");
+      dims[4 - e.shape.size() + i] = int(e.shape[i]);
+      overflow |= __builtin_mul_overflow(numel, e.shape[i], &numel);
+    }
+    const size_t size = e.end - e.begin;
+    if (overflow || size % sizeof(typename GL::dtype) != 0 || numel != size / sizeof(typename GL::dtype)) throw std::runtime_error("Size of " + name + " does not match its shape");
+    if (!e.device && numel) materialize(e, residency, stream);
+    return make_gl<GL>(reinterpret_cast<uint64_t>(e.device), dims[0], dims[1], dims[2], dims[3]);
+  }
+
+  /**
+   * @brief Waits for every upload enqueued so far and releases the page locks they held.
+   */
+  inline void synchronize() {
+    reap(true);
+    for (int b = 0; b < 2; b++)
+      if (staged[b]) hipCheck(hipEventSynchronize(staged[b]));
+  }
+};
+
+} // namespace kittens
@@ -0,0 +1,504 @@
+/**
+ * @file
+ * @brief Host-side emulation of 64-lane wavefronts running kittens tile ops.
+ *
+ * Build with a plain host compiler (no -x hip) and -DKITTENS_EMULATOR. Lane-local ops (load, store,
+ * maps, assignment) run the real kittens code once per lane, so register layouts are exactly the
+ * ones the GPU sees. Cross-lane ops (MFMA) cannot be expressed per lane and are reproduced here at
+ * wave granularity instead.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "../common/common.hpp"
+#include "../types/types.hpp"
+#include "../ops/warp/memory/tile/global_to_register.hpp"
+#include "../ops/warp/memory/tile/global_to_shared.hpp"
+#include "../ops/warp/memory/tile/shared_to_register.hpp"
+#include "../ops/warp/memory/vec/global_to_register.hpp"
+#include "../ops/warp/register/tile/maps.hpp"
+#include "../ops/warp/register/tile/reductions.hpp"
+
+namespace kittens {
+namespace emulator {
+
+/* ----------  EXECUTION  ---------- */
+
+/**
+ * @brief Runs a lane-local function once for every lane of the current wave.
+ *
+ * @param fn[in] Callable taking the lane index. laneid() returns the same index while it runs.
+ */
+template <typename F>
+inline void for_each_lane(F &&fn) {
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    current_lane = lane;
+    fn(lane);
+  }
+  current_lane = 0;
+}
+
+/**
+ * @brief Runs a function once for every wave of a block, in order.
+ *
+ * Use this inside a block-level launch to emulate the phases between two __syncthreads().
+ *
+ * @param num_waves[in] Number of waves in the block.
+ * @param fn[in] Callable taking the wave index. waveid() returns the same index while it runs.
+ */
+template <typename F>
+inline void for_each_wave(int num_waves, F &&fn) {
+  for (int wave = 0; wave < num_waves; wave++) {
+    current_wave = wave;
+    fn(wave);
+  }
+  current_wave = 0;
+}
+
+/**
+ * @brief Emulates a grid launch, running blocks in parallel across host cores.
+ *
+ * @param grid[in] Grid dimensions, as they would be passed to <<<grid, block>>>.
+ * @param kernel[in] Callable taking the block index. All waves of a block run on the same host thread.
+ */
+template <typename F>
+inline void launch(dim3 grid, F &&kernel) {
+  const int64_t num_blocks = int64_t(grid.x) * grid.y * grid.z;
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t block = 0; block < num_blocks; block++) {
+    kernel(dim3(block % grid.x, (block / grid.x) % grid.y, block / (int64_t(grid.x) * grid.y)));
+  }
+}
+
+/**
+ * @brief Emulates a grid launch of independent waves, running them in parallel across host cores.
+ *
+ * Waves of the same block may run on different host threads, so they must not communicate.
+ *
+ * @param grid[in] Grid dimensions, as they would be passed to <<<grid, block>>>.
+ * @param num_waves[in] Number of waves per block.
+ * @param kernel[in] Callable taking the block index and the wave index within the block.
+ */
+template <typename F>
+inline void launch(dim3 grid, int num_waves, F &&kernel) {
+  const int64_t num_blocks = int64_t(grid.x) * grid.y * grid.z;
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t i = 0; i < num_blocks * num_waves; i++) {
+    int64_t block = i / num_waves;
+    current_wave = i % num_waves;
+    kernel(dim3(block % grid.x, (block / grid.x) % grid.y, block / (int64_t(grid.x) * grid.y)), current_wave);
+  }
+}
+
+/* ----------  REGISTERS  ---------- */
+
+/**
+ * @brief The registers of one object (usually an rt) across every lane of a wave.
+ *
+ * @tparam RT The per-lane type, exactly as a kernel would declare it.
+ */
+template <typename RT>
+struct wave {
+  RT lanes[WAVE_THREADS];
+
+  inline RT &operator[](int lane) { return lanes[lane]; }
+  inline const RT &operator[](int lane) const { return lanes[lane]; }
+
+  inline void operator=(const typename RT::T &value) {
+    for_each_lane([&](int lane) { lanes[lane] = value; });
+  }
+  template <typename U>
+  inline void operator=(const wave<U> &other) {
+    for_each_lane([&](int lane) { lanes[lane] = other[lane]; });
+  }
+};
+
+/* ----------  LANE-LOCAL OPS  ---------- */
+
+template <int axis, typename RT, typename SRC>
+inline void load(wave<RT> &dst, const SRC &src, const coord<RT> &idx) {
+  for_each_lane([&](int lane) { kittens::load<axis>(dst[lane], src, idx); });
+}
+template <typename RT, typename SRC>
+inline void load(wave<RT> &dst, const SRC &src, const coord<RT> &idx) {
+  for_each_lane([&](int lane) { kittens::load(dst[lane], src, idx); });
+}
+template <typename RT, typename SRC>
+inline void load_bounded(wave<RT> &dst, const SRC &src, const coord<RT> &idx) {
+  for_each_lane([&](int lane) { kittens::load_bounded(dst[lane], src, idx); });
+}
+template <typename RT, typename SRC>
+inline void load_scaled(wave<RT> &dst, const SRC &src, const coord<RT> &idx, float scale) {
+  for_each_lane([&](int lane) { kittens::load_scaled(dst[lane], src, idx, scale); });
+}
+
+template <typename op, typename RT>
+inline void unary_map(wave<RT> &dst, const wave<RT> &src) {
+  for_each_lane([&](int lane) { kittens::unary_map<op>(dst[lane], src[lane]); });
+}
+template <typename op, typename RT, typename U>
+inline void bin_map(wave<RT> &dst, const wave<RT> &src, const U &param) {
+  for_each_lane([&](int lane) { kittens::bin_map<op>(dst[lane], src[lane], param); });
+}
+template <typename op, typename RT>
+inline void bin_map(wave<RT> &dst, const wave<RT> &lhs, const wave<RT> &rhs) {
+  for_each_lane([&](int lane) { kittens::bin_map<op>(dst[lane], lhs[lane], rhs[lane]); });
+}
+
+template <typename op, typename RT, typename RV>
+inline void row_map(wave<RT> &dst, const wave<RT> &src, const wave<RV> &row_values) {
+  for_each_lane([&](int lane) { kittens::row_map<op>(dst[lane], src[lane], row_values[lane]); });
+}
+template <typename op, typename RT, typename RV>
+inline void col_map(wave<RT> &dst, const wave<RT> &src, const wave<RV> &col_values) {
+  for_each_lane([&](int lane) { kittens::col_map<op>(dst[lane], src[lane], col_values[lane]); });
+}
+
+template <typename RT>
+inline void zero(wave<RT> &dst) {
+  unary_map<base_ops::zero>(dst, dst);
+}
+
+template <ducks::gl::all GL, ducks::rv::all RV>
+inline void store(GL &dst, const wave<RV> &src, const coord<RV> &idx) {
+  for_each_lane([&](int lane) { kittens::store(dst, src[lane], idx); });
+}
+template <ducks::gl::all GL, ducks::rv::all RV>
+inline void store_bounded(GL &dst, const wave<RV> &src, const coord<RV> &idx) {
+  for_each_lane([&](int lane) { kittens::store_bounded(dst, src[lane], idx); });
+}
+
+/* ----------  CROSS-LANE OPS  ---------- */
+
+namespace detail {
+/**
+ * @brief Reproduces v_mfma_f32_32x32x8bf16_1k (or its fp16 twin) for a whole wave.
+ *
+ * Lane l supplies A[l % 32][4 * (l / 32) + i] and B[l % 32][4 * (l / 32) + i] for i in [0, 4), and element e
+ * of its accumulator holds D[8 * (e / 4) + 4 * (l / 32) + e % 4][l % 32].
+ */
+template <typename T>
+inline void mfma_32x32x8(float *const d[WAVE_THREADS], const T *const a[WAVE_THREADS], const T *const b[WAVE_THREADS]) {
+  float a_f[32][8], b_f[32][8];
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int i = 0; i < 4; i++) {
+      a_f[lane % 32][4 * (lane / 32) + i] = base_types::convertor<float, T>::convert(a[lane][i]);
+      b_f[lane % 32][4 * (lane / 32) + i] = base_types::convertor<float, T>::convert(b[lane][i]);
+    }
+  }
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int e = 0; e < 16; e++) {
+      const float *a_row = a_f[8 * (e / 4) + 4 * (lane / 32) + e % 4];
+      const float *b_row = b_f[lane % 32];
+      float acc = d[lane][e];
+      for (int k = 0; k < 8; k++)
+        acc += a_row[k] * b_row[k];
+      d[lane][e] = acc;
+    }
+  }
+}
+
+/**
+ * @brief Reproduces kittens::detail::mma_operand for a whole wave, including the half-wave swap of col-layout tiles.
+ *
+ * @param frag[out] For each lane, the 4 values of k-step 0 followed by the 4 of k-step 1.
+ */
+template <typename RT>
+inline void mma_operand(typename RT::T (&frag)[WAVE_THREADS][8], const wave<RT> &src, int outer, int kt) {
+  using T = typename RT::T;
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    if constexpr (std::is_same_v<typename RT::layout, ducks::rt_layout::row>) {
+      std::memcpy(frag[lane], src[lane].tiles[outer][kt].data, sizeof(frag[lane]));
+    } else {
+      const T *own = reinterpret_cast<const T *>(src[lane].tiles[kt / 2][2 * outer + kt % 2].data);
+      const T *other = reinterpret_cast<const T *>(src[lane ^ 32].tiles[kt / 2][2 * outer + kt % 2].data);
+      const bool upper = lane >= 32;
+      std::memcpy(&frag[lane][0], upper ? &other[4] : &own[0], 4 * sizeof(T));
+      std::memcpy(&frag[lane][4], upper ? &own[4] : &other[0], 4 * sizeof(T));
+    }
+  }
+}
+
+/**
+ * @brief Reproduces v_mfma_f32_32x32x16_{fp8,bf8}_{fp8,bf8} for a whole wave.
+ *
+ * Lane l supplies A[l % 32][8 * (l / 32) + i] and B[l % 32][8 * (l / 32) + i] for i in [0, 8); the accumulator
+ * layout is the same as for the bf16 MFMA.
+ */
+template <typename TA, typename TB>
+inline void mfma_32x32x16_fp8(float *const d[WAVE_THREADS], const TA *const a[WAVE_THREADS], const TB *const b[WAVE_THREADS]) {
+  float a_f[32][16], b_f[32][16];
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int i = 0; i < 8; i++) {
+      a_f[lane % 32][8 * (lane / 32) + i] = base_types::convertor<float, TA>::convert(a[lane][i]);
+      b_f[lane % 32][8 * (lane / 32) + i] = base_types::convertor<float, TB>::convert(b[lane][i]);
+    }
+  }
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int e = 0; e < 16; e++) {
+      const float *a_row = a_f[8 * (e / 4) + 4 * (lane / 32) + e % 4];
+      const float *b_row = b_f[lane % 32];
+      float acc = d[lane][e];
+      for (int k = 0; k < 16; k++)
+        acc += a_row[k] * b_row[k];
+      d[lane][e] = acc;
+    }
+  }
+}
+
+/**
+ * @brief Reproduces kittens::detail::swap_across_lanes for a whole wave, one __shfl_xor per index pair.
+ */
+template <int lane_mask, int elem_mask, int N>
+inline void swap_across_lanes(float (&v)[WAVE_THREADS][N]) {
+  float sent[WAVE_THREADS][N];
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    const bool upper = lane & lane_mask;
+    for (int s = 0; s < N; s++) {
+      if (!(s & elem_mask)) sent[lane][s] = upper ? v[lane][s] : v[lane][s | elem_mask];
+    }
+  }
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    const bool upper = lane & lane_mask;
+    for (int s = 0; s < N; s++) {
+      if (s & elem_mask) continue;
+      if (upper) v[lane][s] = sent[lane ^ lane_mask][s];
+      else v[lane][s | elem_mask] = sent[lane ^ lane_mask][s];
+    }
+  }
+}
+
+/**
+ * @brief Reproduces kittens::detail::butterfly_reduce for a whole wave.
+ */
+template <typename op, int step, ducks::rv::all RV>
+inline void butterfly_reduce(wave<RV> &v) {
+  using dtype = typename RV::dtype;
+  dtype moved[WAVE_THREADS][RV::outer_dim][RV::inner_dim];
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int o = 0; o < RV::outer_dim; o++) {
+      for (int i = 0; i < RV::inner_dim; i++)
+        moved[lane][o][i] = v[butterfly_lane<step>(lane)][o][i];
+    }
+  }
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    for (int o = 0; o < RV::outer_dim; o++) {
+      for (int i = 0; i < RV::inner_dim; i++)
+        v[lane][o][i] = op::template op<dtype>(v[lane][o][i], moved[lane][o][i]);
+    }
+  }
+}
+/**
+ * @brief Reproduces kittens::detail::reduce_across_lanes for a whole wave, with the same steps in the same order.
+ */
+template <typename op, ducks::rv::all RV>
+inline void reduce_across_lanes(wave<RV> &v) {
+  if constexpr (std::is_same_v<typename RV::layout, ducks::rv_layout::ortho>) {
+    butterfly_reduce<op, 32>(v);
+  } else {
+    butterfly_reduce<op, 1>(v);
+    butterfly_reduce<op, 2>(v);
+    butterfly_reduce<op, 4>(v);
+    butterfly_reduce<op, 8>(v);
+    butterfly_reduce<op, 16>(v);
+  }
+}
+
+template <int axis, bool bounded, ducks::gl::all GL, ducks::rt::col_layout RT>
+inline void store_rt(GL &dst, const wave<RT> &src, const coord<RT> &idx) {
+  static_assert(RT::width % 2 == 0, "RT::width must be even");
+  using U = typename GL::dtype;
+
+  const int row_stride = dst.template stride<axis>();
+  const int num_rows = dst.template shape<axis>();
+  const int num_cols = dst.cols();
+  const bool aligned = kittens::detail::rows_are_chunk_aligned<U>(row_stride);
+  for (int row_tile = 0; row_tile < RT::height; row_tile++) {
+    for (int n = 0; n < RT::width / 2; n++) {
+      auto new_coord = idx.template unit_coord<axis, 3>();
+      new_coord.r += row_tile * RT::tile_size_row;
+      new_coord.c += 2 * n * RT::tile_size_col;
+      auto dst_ptr = (U *)&dst[(new_coord)];
+
+      float v[WAVE_THREADS][16];
+      for_each_lane([&](int lane) { kittens::detail::gather_acc_tile(v[lane], src[lane], row_tile, n); });
+      swap_across_lanes<1, 1>(v);
+      swap_across_lanes<2, 2>(v);
+      if constexpr (sizeof(U) == 2) {
+        swap_across_lanes<4, 4>(v);
+      }
+      const int rows_left = num_rows - kittens::detail::coord_along<axis>(new_coord);
+      const int cols_left = num_cols - new_coord.c;
+      for_each_lane([&](int lane) {
+        if constexpr (bounded) kittens::detail::store_acc_tile<true>(dst_ptr, row_stride, v[lane], rows_left, cols_left, aligned);
+        else kittens::detail::store_acc_tile<false>(dst_ptr, row_stride, v[lane]);
+      });
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Wave-level equivalent of kittens::store for accumulator tiles, including its cross-lane shuffles.
+ */
+template <int axis, ducks::gl::all GL, ducks::rt::col_layout RT>
+inline void store(GL &dst, const wave<RT> &src, const coord<RT> &idx) {
+  detail::store_rt<axis, false>(dst, src, idx);
+}
+template <ducks::gl::all GL, ducks::rt::col_layout RT>
+inline void store(GL &dst, const wave<RT> &src, const coord<RT> &idx) {
+  store<2>(dst, src, idx);
+}
+template <int axis, ducks::gl::all GL, ducks::rt::col_layout RT>
+inline void store_bounded(GL &dst, const wave<RT> &src, const coord<RT> &idx) {
+  detail::store_rt<axis, true>(dst, src, idx);
+}
+template <ducks::gl::all GL, ducks::rt::col_layout RT>
+inline void store_bounded(GL &dst, const wave<RT> &src, const coord<RT> &idx) {
+  store_bounded<2>(dst, src, idx);
+}
+
+/**
+ * @brief Wave-level equivalent of kittens::row_reduce.
+ */
+template <typename op, ducks::rv::all RV, ducks::rt::all RT, bool reset>
+inline void row_reduce(wave<RV> &row_accum, const wave<RT> &src, const wave<RV> &src_accum) {
+  wave<RV> partial;
+  for_each_lane([&](int lane) { kittens::detail::row_reduce_lane<op>(partial[lane], src[lane]); });
+  detail::reduce_across_lanes<op>(partial);
+  for_each_lane([&](int lane) { kittens::detail::accumulate_reduction<op, reset>(row_accum[lane], partial[lane], src_accum[lane]); });
+}
+/**
+ * @brief Wave-level equivalent of kittens::col_reduce.
+ */
+template <typename op, ducks::rv::all RV, ducks::rt::all RT, bool reset>
+inline void col_reduce(wave<RV> &col_accum, const wave<RT> &src, const wave<RV> &src_accum) {
+  wave<RV> partial;
+  for_each_lane([&](int lane) { kittens::detail::col_reduce_lane<op>(partial[lane], src[lane]); });
+  detail::reduce_across_lanes<op>(partial);
+  for_each_lane([&](int lane) { kittens::detail::accumulate_reduction<op, reset>(col_accum[lane], partial[lane], src_accum[lane]); });
+}
+
+template <typename RV, typename RT>
+inline void row_max(wave<RV> &row_accum, const wave<RT> &src) { row_reduce<base_ops::max, RV, RT, true>(row_accum, src, row_accum); }
+template <typename RV, typename RT>
+inline void row_max(wave<RV> &row_accum, const wave<RT> &src, const wave<RV> &src_accum) { row_reduce<base_ops::max, RV, RT, false>(row_accum, src, src_accum); }
+template <typename RV, typename RT>
+inline void row_sum(wave<RV> &row_accum, const wave<RT> &src) { row_reduce<base_ops::sum, RV, RT, true>(row_accum, src, row_accum); }
+template <typename RV, typename RT>
+inline void row_sum(wave<RV> &row_accum, const wave<RT> &src, const wave<RV> &src_accum) { row_reduce<base_ops::sum, RV, RT, false>(row_accum, src, src_accum); }
+template <typename RV, typename RT>
+inline void col_max(wave<RV> &col_accum, const wave<RT> &src) { col_reduce<base_ops::max, RV, RT, true>(col_accum, src, col_accum); }
+template <typename RV, typename RT>
+inline void col_max(wave<RV> &col_accum, const wave<RT> &src, const wave<RV> &src_accum) { col_reduce<base_ops::max, RV, RT, false>(col_accum, src, src_accum); }
+template <typename RV, typename RT>
+inline void col_sum(wave<RV> &col_accum, const wave<RT> &src) { col_reduce<base_ops::sum, RV, RT, true>(col_accum, src, col_accum); }
+template <typename RV, typename RT>
+inline void col_sum(wave<RV> &col_accum, const wave<RT> &src, const wave<RV> &src_accum) { col_reduce<base_ops::sum, RV, RT, false>(col_accum, src, src_accum); }
+
+namespace detail {
+/**
+ * @brief Wave-level equivalent of kittens::detail::mma: C += op(A) * op(B), transposing col-layout inputs.
+ */
+template <typename CT, typename AT, typename BT>
+inline void mma(wave<CT> &c_reg, const wave<AT> &a_reg, const wave<BT> &b_reg) {
+  using T = typename AT::T;
+  constexpr bool trans_a = std::is_same_v<typename AT::layout, ducks::rt_layout::col>;
+  constexpr int M = CT::rows, N = CT::cols;
+  constexpr int K = trans_a ? AT::rows : AT::cols;
+  static_assert(M % 32 == 0 && N % 32 == 0 && K % 16 == 0, "M and N must be divisible by 32, K by 16");
+
+  if constexpr (std::is_same_v<typename CT::T, half>) {
+    // Per host thread: launch() runs blocks concurrently, and this is too large to keep on the stack
+    thread_local wave<rt_fl<M, N, ducks::rt_layout::col>> acc;
+    for_each_lane([&](int lane) { acc[lane] = c_reg[lane]; });
+    mma(acc, a_reg, b_reg);
+    for_each_lane([&](int lane) { c_reg[lane] = acc[lane]; });
+  } else {
+    T a_frag[WAVE_THREADS][8], b_frag[WAVE_THREADS][8];
+    float *c[WAVE_THREADS];
+    const T *a[WAVE_THREADS], *b[WAVE_THREADS];
+    for (int m = 0; m < M / 32; m++) {
+      for (int n = 0; n < N / 32; n++) {
+        for (int k = 0; k < K / 16; k++) {
+          mma_operand(a_frag, a_reg, m, k);
+          mma_operand(b_frag, b_reg, n, k);
+          // Same decomposition as the device: two 32x32x8 steps per 16-wide k-tile
+          for (int step = 0; step < 2; step++) {
+            for (int lane = 0; lane < WAVE_THREADS; lane++) {
+              c[lane] = reinterpret_cast<float *>(&c_reg[lane].tiles[m][2 * n].data[0]);
+              a[lane] = &a_frag[lane][4 * step];
+              b[lane] = &b_frag[lane][4 * step];
+            }
+            mfma_32x32x8(c, a, b);
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Wave-level equivalent of kittens::mma_AB, with the same register layouts.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+inline void mma_AB(wave<rt<TC, M, N, ducks::rt_layout::col>> &c_reg, const wave<rt<T, M, K, ducks::rt_layout::row>> &a_reg, const wave<rt<T, K, N, ducks::rt_layout::col>> &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Wave-level equivalent of kittens::mma_ABt, with the same register layouts.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+inline void mma_ABt(wave<rt<TC, M, N, ducks::rt_layout::col>> &c_reg, const wave<rt<T, M, K, ducks::rt_layout::row>> &a_reg, const wave<rt<T, N, K, ducks::rt_layout::row>> &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Wave-level equivalent of kittens::mma_AtB, with the same register layouts.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+inline void mma_AtB(wave<rt<TC, M, N, ducks::rt_layout::col>> &c_reg, const wave<rt<T, K, M, ducks::rt_layout::col>> &a_reg, const wave<rt<T, K, N, ducks::rt_layout::col>> &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Wave-level equivalent of kittens::mma_AtBt, with the same register layouts.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+inline void mma_AtBt(wave<rt<TC, M, N, ducks::rt_layout::col>> &c_reg, const wave<rt<T, K, M, ducks::rt_layout::col>> &a_reg, const wave<rt<T, N, K, ducks::rt_layout::row>> &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+
+/**
+ * @brief Wave-level equivalent of the fp8 kittens::mma_ABt, with the same register layouts.
+ */
+template <int M, int N, int K, ducks::base_types::fp8 TA, ducks::base_types::fp8 TB>
+inline void mma_ABt(wave<rt_fl<M, N, ducks::rt_layout::col>> &c_reg, const wave<rt<TA, M, K, ducks::rt_layout::row>> &a_reg, const wave<rt<TB, N, K, ducks::rt_layout::row>> &b_reg) {
+  static_assert(M % 32 == 0, "M must be divisible by 32");
+  static_assert(N % 32 == 0, "N must be divisible by 32");
+  static_assert(K % 32 == 0, "K must be divisible by 32");
+
+  float *c[WAVE_THREADS];
+  const TA *a[WAVE_THREADS];
+  const TB *b[WAVE_THREADS];
+  for (int m = 0; m < M / 32; m++) {
+    for (int n = 0; n < N / 32; n++) {
+      for (int k = 0; k < K / 32; k++) {
+        // Same decomposition as the device: two 32x32x16 steps, each reading 8 of the 16 values a lane holds
+        for (int step = 0; step < 2; step++) {
+          for (int lane = 0; lane < WAVE_THREADS; lane++) {
+            c[lane] = reinterpret_cast<float *>(&c_reg[lane].tiles[m][2 * n].data[0]);
+            a[lane] = reinterpret_cast<const TA *>(a_reg[lane].tiles[m][k].data) + 8 * step;
+            b[lane] = reinterpret_cast<const TB *>(b_reg[lane].tiles[n][k].data) + 8 * step;
+          }
+          detail::mfma_32x32x16_fp8(c, a, b);
+        }
+      }
+    }
+  }
+}
+
+} // namespace emulator
+} // namespace kittens
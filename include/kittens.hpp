@@ -1,5 +1,17 @@
+#pragma once
+
 #include "common/common.hpp"
 #include "types/types.hpp"
+#include "common/weights.hpp"
 #include "ops/warp/memory/tile/global_to_register.hpp"
+#include "ops/warp/memory/tile/global_to_shared.hpp"
+#include "ops/warp/memory/tile/shared_to_register.hpp"
+#include "ops/warp/memory/vec/global_to_register.hpp"
 #include "ops/warp/register/tile/maps.hpp"
-#include "ops/warp/mfma/mfma.hpp"
\ No newline at end of file
+#include "ops/warp/register/tile/reductions.hpp"
+#include "ops/warp/register/vec/maps.hpp"
+#include "ops/warp/mfma/mfma.hpp"
+#include "ops/group/group.hpp"
+#ifdef KITTENS_EMULATOR
+#include "emulator/emulator.hpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Operations run cooperatively by several waves of a block.
+ */
+
+#pragma once
+
+#include "../../common/common.hpp"
+#include "../../types/types.hpp"
+#include "../warp/memory/tile/global_to_shared.hpp"
+
+namespace kittens {
+
+/**
+ * @brief Cooperative operations over a group of consecutive waves.
+ *
+ * @tparam N_WAVES Number of waves in the group. Waves [k * N_WAVES, (k + 1) * N_WAVES) of a block form group k.
+ *
+ * Usage: kittens::group<4>::load(a_smem, g.A, {tile_m, tile_k});
+ */
+template <int N_WAVES>
+struct group {
+  static constexpr int GROUP_WAVES = N_WAVES;                  ///< Number of waves in the group.
+  static constexpr int GROUP_THREADS = N_WAVES * WAVE_THREADS; ///< Number of threads in the group.
+
+  /**
+   * @brief Get the index of the current thread within its group.
+   */
+  __device__ static inline int laneid() { return (kittens::waveid() % N_WAVES) * WAVE_THREADS + kittens::laneid(); }
+
+  /**
+   * @brief Loads a tile from global memory into shared memory, split across every thread of the group.
+   */
+  template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void load(ST &dst, const GL &src, const COORD &idx) {
+    detail::load_st<GROUP_THREADS, axis, false>(dst, src, idx, laneid());
+  }
+  template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void load(ST &dst, const GL &src, const COORD &idx) {
+    load<2>(dst, src, idx);
+  }
+  /**
+   * @brief Like load(), but elements outside the runtime dimensions of src read as zero.
+   */
+  template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void load_bounded(ST &dst, const GL &src, const COORD &idx) {
+    detail::load_st<GROUP_THREADS, axis, true>(dst, src, idx, laneid());
+  }
+  template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void load_bounded(ST &dst, const GL &src, const COORD &idx) {
+    load_bounded<2>(dst, src, idx);
+  }
+
+  /**
+   * @brief Registers holding this thread's share of a shared tile between prefetch() and commit().
+   */
+  template <ducks::st::all ST>
+  using prefetch_buffer = detail::st_prefetch_buffer<GROUP_THREADS, ST>;
+
+  /**
+   * @brief First half of load(): issues the global reads for a tile without waiting on them.
+   *
+   * The reads stay in flight until commit() consumes the buffer, so independent work placed in
+   * between (typically the MFMAs of the previous stage) hides their latency.
+   */
+  template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void prefetch(prefetch_buffer<ST> &buf, const GL &src, const COORD &idx) {
+    detail::prefetch_st<GROUP_THREADS, axis, false>(buf, src, idx, laneid());
+  }
+  template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void prefetch(prefetch_buffer<ST> &buf, const GL &src, const COORD &idx) {
+    prefetch<2>(buf, src, idx);
+  }
+  /**
+   * @brief Like prefetch(), but elements outside the runtime dimensions of src read as zero.
+   */
+  template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void prefetch_bounded(prefetch_buffer<ST> &buf, const GL &src, const COORD &idx) {
+    detail::prefetch_st<GROUP_THREADS, axis, true>(buf, src, idx, laneid());
+  }
+  template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+  __device__ static inline void prefetch_bounded(prefetch_buffer<ST> &buf, const GL &src, const COORD &idx) {
+    prefetch_bounded<2>(buf, src, idx);
+  }
+  /**
+   * @brief Second half of load(): writes a prefetched tile into shared memory.
+   */
+  template <ducks::st::all ST>
+  __device__ static inline void commit(ST &dst, const prefetch_buffer<ST> &buf) {
+    detail::commit_st<GROUP_THREADS>(dst, buf, laneid());
+  }
+};
+
+} // namespace kittens
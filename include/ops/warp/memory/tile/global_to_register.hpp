@@ -6,20 +6,21 @@
 #pragma once
 
 #include "../../../../common/common.hpp"
+#include "../util/util.hpp"
 
 namespace kittens {
 
 namespace detail {
 
-template <typename T, typename U>
+template <int tile_cols, typename T, typename U>
 __device__ inline void load_rt_base(T *global, int global_cols, U *reg) {
   constexpr int REG_TILE_SIZE_M = 32;
-  constexpr int REG_TILE_SIZE_K = 16;
+  constexpr int REG_TILE_SIZE_K = tile_cols;
 
   static_assert(WAVE_THREADS % REG_TILE_SIZE_M == 0, "WAVE_THREADS must be divisible by REG_TILE_SIZE_M");
   constexpr int contiguous_elements_to_load = REG_TILE_SIZE_K / (WAVE_THREADS / REG_TILE_SIZE_M);
 
-  static_assert(contiguous_elements_to_load == 8, "TEST FAILED: contiguous_elements_to_load != 8");
+  static_assert(contiguous_elements_to_load * sizeof(T) == 16, "each lane reads one 16-byte chunk of its row");
 
   int stride_bw_rows = global_cols;
   using T2 = std::array<T, contiguous_elements_to_load>;
@@ -38,15 +39,31 @@ __device__ inline void load_rt_base(T *global, int global_cols, U *reg) {
   // Assume both global and reg are row-major
   *reinterpret_cast<T2 *>(reg) = *reinterpret_cast<T2 *>(global_ptr);
 }
-} // namespace detail
 
-template <int axis, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
-__device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
-  using T2 = RT::dtype;
+template <int tile_cols, typename T, typename U>
+__device__ inline void load_rt_base_bounded(const T *global, int global_cols, U *reg, int rows_left, int cols_left, bool aligned) {
+  constexpr int REG_TILE_SIZE_M = 32;
+  constexpr int REG_TILE_SIZE_K = tile_cols;
+  constexpr int contiguous_elements_to_load = REG_TILE_SIZE_K / (WAVE_THREADS / REG_TILE_SIZE_M);
+  static_assert(contiguous_elements_to_load * sizeof(T) == 16, "bounded loads read one 16-byte chunk per lane");
+
+  int laneid = kittens::laneid();
+
+  int row_win_tile = laneid % REG_TILE_SIZE_M;
+  int col_win_tile = (laneid / REG_TILE_SIZE_M) * contiguous_elements_to_load;
+
+  int cols_in_bounds = row_win_tile < rows_left ? cols_left - col_win_tile : 0;
+  *reinterpret_cast<int4 *>(reg) = load_chunk_bounded(&global[row_win_tile * global_cols + col_win_tile], cols_in_bounds, aligned);
+}
+
+template <int axis, bool bounded, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD>
+__device__ inline void load_rt(RT &dst, const GL &src, const COORD &idx) {
   using U = typename GL::dtype;
 
   const int row_stride = src.template stride<axis>();
-  using U2 = typename base_types::packing<U>::packed_type;
+  const int num_rows = src.template shape<axis>();
+  const int num_cols = src.cols();
+  const bool aligned = rows_are_chunk_aligned<U>(row_stride);
 
 #pragma unroll
   for (int row_tile = 0; row_tile < RT::height; row_tile++) {
@@ -59,81 +76,353 @@ __device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
       auto src_ptr = (U *)&src[(new_coord)];
 
       auto &base_tile = dst.tiles[row_tile][col_tile];
-      detail::load_rt_base(src_ptr, row_stride, base_tile.data);
+      if constexpr (bounded) {
+        const int rows_left = num_rows - coord_along<axis>(new_coord);
+        const int cols_left = num_cols - new_coord.c;
+        if (!aligned || rows_left < RT::tile_size_row || cols_left < RT::tile_size_col) {
+          load_rt_base_bounded<RT::tile_size_col>(src_ptr, row_stride, base_tile.data, rows_left, cols_left, aligned);
+          continue;
+        }
+      }
+      load_rt_base<RT::tile_size_col>(src_ptr, row_stride, base_tile.data);
     }
   }
 }
+} // namespace detail
+
+/**
+ * @brief Loads a row-layout register tile from global memory.
+ *
+ * The tile must lie entirely within src; see load_bounded() for tiles that may not.
+ *
+ * @param dst[out] Destination register tile.
+ * @param src[in] Source global layout.
+ * @param idx[in] Coordinate of the tile within src, in units of the tile.
+ */
+template <int axis, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
+  detail::load_rt<axis, false>(dst, src, idx);
+}
 
 template <ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
 __device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
   load<2>(dst, src, idx);
 }
 
+/**
+ * @brief Like load(), but elements outside the runtime dimensions of src read as zero.
+ *
+ * Tiles that lie entirely within src take the same vectorized path as load(); only tiles crossing the
+ * edge, or layouts whose rows are not 16-byte aligned, are read chunk by chunk with predication.
+ */
+template <int axis, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_bounded(RT &dst, const GL &src, const COORD &idx) {
+  detail::load_rt<axis, true>(dst, src, idx);
+}
+
+template <ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_bounded(RT &dst, const GL &src, const COORD &idx) {
+  load_bounded<2>(dst, src, idx);
+}
+
 namespace detail {
-template <typename T, typename U>
-__device__ inline void store_rt_base(T *global, int global_cols, U *reg) {
-  constexpr int REG_TILE_SIZE_M = 32;
-  constexpr int REG_TILE_SIZE_N = 32;
+/**
+ * @brief Loads a row-layout tile from a global layout of any element type, multiplying every element by scale.
+ *
+ * Each lane reads the same row fragment as load_rt(), converts it through fp32 and packs it into the
+ * element type of dst. Elements outside the runtime dimensions of src read as zero.
+ */
+template <int axis, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD>
+__device__ inline void load_rt_scaled(RT &dst, const GL &src, const COORD &idx, float scale) {
+  using U = typename GL::dtype;
+  using T2 = typename RT::dtype;
+  constexpr int packing = base_types::packing<T2>::num();
+  static_assert(packing == 2 || packing == 4, "scaled loads pack into 2- or 4-element words");
+  using F = std::conditional_t<packing == 4, float4, float2>;
+  constexpr int contiguous_elements_to_load = RT::tile_size_col / (WAVE_THREADS / RT::tile_size_row);
 
-  constexpr int contiguous_elements_to_store = REG_TILE_SIZE_N / (WAVE_THREADS / REG_TILE_SIZE_M);
-  constexpr bool should_swizzle_4_slices = true;
+  const int row_stride = src.template stride<axis>();
+  const auto origin = idx.template unit_coord<axis, 3>();
+  const int rows_left = int(src.template shape<axis>()) - coord_along<axis>(origin);
+  const int cols_left = int(src.cols()) - origin.c;
+  const U *src_ptr = &src[origin];
+  const int lane = kittens::laneid();
 
-  int laneid = threadIdx.x % WAVE_THREADS;
+#pragma unroll
+  for (int row_tile = 0; row_tile < RT::height; row_tile++) {
+    const int row = row_tile * RT::tile_size_row + lane % RT::tile_size_row;
+#pragma unroll
+    for (int col_tile = 0; col_tile < RT::width; col_tile++) {
+      const int col = col_tile * RT::tile_size_col + (lane / RT::tile_size_row) * contiguous_elements_to_load;
+#pragma unroll
+      for (int k = 0; k < RT::packed_per_tile; k++) {
+        alignas(16) float vals[packing];
+#pragma unroll
+        for (int e = 0; e < packing; e++) {
+          const int c = col + k * packing + e;
+          vals[e] = row < rows_left && c < cols_left ? base_types::convertor<float, U>::convert(src_ptr[row * row_stride + c]) * scale : 0.f;
+        }
+        dst.tiles[row_tile][col_tile].data[k] = base_types::convertor<T2, F>::convert(*reinterpret_cast<const F *>(vals));
+      }
+    }
+  }
+}
+} // namespace detail
 
-  int row_win_tile = laneid % REG_TILE_SIZE_M;
-  int col_win_tile = (laneid / REG_TILE_SIZE_M) * contiguous_elements_to_store;
-
-#pragma unroll
-  for (int i = 0; i < contiguous_elements_to_store; i++) {
-    // printf("laneid: %d, i: %d, row_win_tile: %d, col_win_tile: %d\n", laneid, i, row_win_tile, col_win_tile);
-    // Assume RT is col-major and global is row-major -- here, we use the (col, row) coordinates from within the tile instead of (row, col)
-    int global_row_offset = col_win_tile + i;
-    int global_col_offset = row_win_tile;
-
-    if (should_swizzle_4_slices) {
-      int row_group_idx = global_row_offset / 4;
-      int row_win_tile_group = global_row_offset % 4;
-      // Express the following transformation: Let i = row_tile_group_idx. We need to remap i to i' such that:
-      // 0 -> 0, 1 -> 4, 2 -> 1, 3 -> 5, 4 -> 2, 5 -> 6, 6 -> 3, 7 -> 7
-      int row_win_tile_swizzled = (2 * (row_group_idx % 4) + (row_group_idx / 4)) * 4 + row_win_tile_group;
-      global_row_offset = row_win_tile_swizzled;
+/**
+ * @brief Loads a register tile from global memory of any element type, scaling each element on the way in.
+ *
+ * This is the quantizing load for fp8 tiles: with scale = fp8_max / amax(src), a bf16 or fp32 layout lands in
+ * an rt_fp8e4m3 using the whole fp8 range. Dequantize the MMA result by 1 / scale. Elements outside the
+ * runtime dimensions of src read as zero.
+ *
+ * @param dst[out] Destination register tile.
+ * @param src[in] Source global layout.
+ * @param idx[in] Coordinate of the tile within src, in units of the tile.
+ * @param scale[in] Factor applied in fp32 before converting to the element type of dst.
+ */
+template <int axis, ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_scaled(RT &dst, const GL &src, const COORD &idx, float scale) {
+  detail::load_rt_scaled<axis>(dst, src, idx, scale);
+}
+
+template <ducks::rt::row_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_scaled(RT &dst, const GL &src, const COORD &idx, float scale) {
+  load_scaled<2>(dst, src, idx, scale);
+}
+
+namespace detail {
+/**
+ * @brief Loads a col-layout tile (the accumulator layout) element by element.
+ *
+ * Value e of a lane in base tile (i, j) comes from row 32 * i + 16 * (j % 2) + 8 * (e / 4) + 4 * (laneid / 32) + e % 4
+ * and column 32 * (j / 2) + laneid % 32, so lanes 0-31 read 32 consecutive elements of one row at a time.
+ *
+ * @tparam bounded Elements outside the runtime dimensions of src read as zero.
+ */
+template <int axis, bool bounded, ducks::rt::col_layout RT, ducks::gl::all GL, ducks::coord::tile COORD>
+__device__ inline void load_rt_col(RT &dst, const GL &src, const COORD &idx) {
+  using T = typename RT::T;
+  using U = typename GL::dtype;
+  static_assert(RT::width % 2 == 0, "RT::width must be even");
+
+  const int row_stride = src.template stride<axis>();
+  const auto origin = idx.template unit_coord<axis, 3>();
+  const int rows_left = bounded ? int(src.template shape<axis>()) - coord_along<axis>(origin) : RT::rows;
+  const int cols_left = bounded ? int(src.cols()) - origin.c : RT::cols;
+  const U *src_ptr = &src[origin];
+  const int lane = kittens::laneid();
+
+#pragma unroll
+  for (int i = 0; i < RT::height; i++) {
+#pragma unroll
+    for (int j = 0; j < RT::width; j++) {
+      const int col = 32 * (j / 2) + lane % 32;
+      T *vals = reinterpret_cast<T *>(dst.tiles[i][j].data);
+#pragma unroll
+      for (int e = 0; e < RT::base_tile::elements_per_thread; e++) {
+        const int row = 32 * i + 16 * (j % 2) + 8 * (e / 4) + 4 * (lane / 32) + e % 4;
+        vals[e] = !bounded || (row < rows_left && col < cols_left) ? base_types::convertor<T, U>::convert(src_ptr[row * row_stride + col]) : base_types::constants<T>::zero();
+      }
     }
-    global[global_row_offset * global_cols + global_col_offset] = reinterpret_cast<T const *>(reg)[i];
   }
 }
 } // namespace detail
 
-template <int axis, ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD = coord<RT>>
-__device__ inline static void store(GL &dst, const RT &src, const COORD &idx) {
+/**
+ * @brief Loads a col-layout register tile from global memory, e.g. the K x N operand of mma_AB.
+ *
+ * Unlike row-layout loads these are scalar, but still coalesced across each half-wave.
+ */
+template <int axis, ducks::rt::col_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
+  detail::load_rt_col<axis, false>(dst, src, idx);
+}
+
+template <ducks::rt::col_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load(RT &dst, const GL &src, const COORD &idx) {
+  load<2>(dst, src, idx);
+}
+
+/**
+ * @brief Like the col-layout load(), but elements outside the runtime dimensions of src read as zero.
+ */
+template <int axis, ducks::rt::col_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_bounded(RT &dst, const GL &src, const COORD &idx) {
+  detail::load_rt_col<axis, true>(dst, src, idx);
+}
+
+template <ducks::rt::col_layout RT, ducks::gl::all GL, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load_bounded(RT &dst, const GL &src, const COORD &idx) {
+  load_bounded<2>(dst, src, idx);
+}
+
+namespace detail {
+/**
+ * @brief Gathers, as fp32, the 16 values a lane holds of the 32x32 accumulator tile at (row_tile, n) of src.
+ *
+ * A 32x32 accumulator spans base tiles 2 * n and 2 * n + 1 of a row. Value e of a lane sits at
+ * row 8 * (e / 4) + 4 * (laneid / 32) + e % 4 and column laneid % 32 of the tile.
+ */
+template <ducks::rt::col_layout RT>
+__device__ inline void gather_acc_tile(float (&v)[16], const RT &src, int row_tile, int n) {
+  using T = typename RT::T;
+#pragma unroll
+  for (int half = 0; half < 2; half++) {
+    const T *data = reinterpret_cast<const T *>(src.tiles[row_tile][2 * n + half].data);
+#pragma unroll
+    for (int e = 0; e < 8; e++) {
+      v[8 * half + e] = base_types::convertor<float, T>::convert(data[e]);
+    }
+  }
+}
+
+#ifndef KITTENS_EMULATOR
+/**
+ * @brief Exchanges half of v with lane (laneid ^ lane_mask).
+ *
+ * For every pair of indices differing only in elem_mask, the lane with lane_mask set gives away the
+ * upper one and the other lane the lower one. Applied with lane_mask == elem_mask for masks 1 and 2
+ * this transposes each group of four values across each quad of lanes.
+ */
+template <int lane_mask, int elem_mask, int N>
+__device__ inline void swap_across_lanes(float (&v)[N]) {
+  const bool upper = kittens::laneid() & lane_mask;
+#pragma unroll
+  for (int s = 0; s < N; s++) {
+    if (s & elem_mask) continue;
+    const float send = upper ? v[s] : v[s | elem_mask];
+    const float recv = __shfl_xor(send, lane_mask);
+    if (upper) v[s] = recv;
+    else v[s | elem_mask] = recv;
+  }
+}
+#endif
+
+/**
+ * @brief Writes a 32x32 accumulator tile to row-major global memory, 16 bytes per store.
+ *
+ * Expects v after the quad transpose (swap_across_lanes<1, 1> then <2, 2>), and for 2-byte outputs after
+ * a further swap_across_lanes<4, 4>. Each lane then owns whole 16-byte row segments, so every store is
+ * a full vector write and the lanes of a quad cover a contiguous run of the row.
+ *
+ * @tparam bounded Skip elements at or past rows_left / cols_left, and fall back to element stores where
+ *         a segment is cut by the edge or aligned is false.
+ * @param global[out] Top-left element of the tile. Unless bounded, the row stride and this pointer must be 16-byte aligned.
+ * @param row_stride[in] Distance between rows of global, in elements.
+ * @param v[in] The lane's exchanged values.
+ */
+template <bool bounded, typename U>
+__device__ inline void store_acc_tile(U *global, int row_stride, const float (&v)[16], int rows_left = 0, int cols_left = 0, bool aligned = true) {
+  constexpr int elements_per_store = 16 / sizeof(U);
+  static_assert(elements_per_store == 4 || elements_per_store == 8, "vectorized stores support 2- and 4-byte outputs");
+  constexpr int num_stores = 16 / elements_per_store;
+
+  const int lane = kittens::laneid();
+  const int row_in_quad = lane % 4;
+  const int half = (lane / 32) % 2;
+  const int quad = (lane % 32) / 4;
+
+#pragma unroll
+  for (int i = 0; i < num_stores; i++) {
+    int row, col;
+    if constexpr (elements_per_store == 4) {
+      row = 8 * i + 4 * half + row_in_quad;
+      col = 4 * quad;
+    } else {
+      row = 8 * (2 * i + quad % 2) + 4 * half + row_in_quad;
+      col = 8 * (quad / 2);
+    }
+    alignas(16) U packed[elements_per_store];
+#pragma unroll
+    for (int e = 0; e < elements_per_store; e++) {
+      packed[e] = base_types::convertor<U, float>::convert(v[i * elements_per_store + e]);
+    }
+    const int4 &chunk = *reinterpret_cast<const int4 *>(packed);
+    if constexpr (bounded) {
+      store_chunk_bounded(&global[row * row_stride + col], chunk, row < rows_left ? cols_left - col : 0, aligned);
+    } else {
+      *reinterpret_cast<int4 *>(&global[row * row_stride + col]) = chunk;
+    }
+  }
+}
+
+#ifndef KITTENS_EMULATOR
+template <int axis, bool bounded, ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD>
+__device__ inline void store_rt(GL &dst, const RT &src, const COORD &idx) {
   static_assert(RT::width % 2 == 0, "RT::width must be even");
-  using T2 = RT::dtype;
   using U = typename GL::dtype;
 
   const int row_stride = dst.template stride<axis>();
-  using U2 = typename base_types::packing<U>::packed_type;
+  const int num_rows = dst.template shape<axis>();
+  const int num_cols = dst.cols();
+  const bool aligned = rows_are_chunk_aligned<U>(row_stride);
 
 #pragma unroll
   for (int row_tile = 0; row_tile < RT::height; row_tile++) {
 #pragma unroll
-    for (int col_tile = 0; col_tile < RT::width; col_tile += 2) {
+    for (int n = 0; n < RT::width / 2; n++) {
       auto new_coord = idx.template unit_coord<axis, 3>();
-      // switch row and col
-      new_coord.c += row_tile * RT::tile_size_row;
-      new_coord.r += col_tile * RT::tile_size_col;
-      // if (threadIdx.x % 64 == 0) {
-      // printf("new_coord: %d, %d, %d, %d\n", new_coord.b, new_coord.d, new_coord.r, new_coord.c);
-      // }
+      new_coord.r += row_tile * RT::tile_size_row;
+      new_coord.c += 2 * n * RT::tile_size_col;
       auto dst_ptr = (U *)&dst[(new_coord)];
 
-      auto &base_tile = src.tiles[row_tile][col_tile];
-      detail::store_rt_base(dst_ptr, row_stride, base_tile.data);
+      float v[16];
+      gather_acc_tile(v, src, row_tile, n);
+      swap_across_lanes<1, 1>(v);
+      swap_across_lanes<2, 2>(v);
+      if constexpr (sizeof(U) == 2) {
+        swap_across_lanes<4, 4>(v);
+      }
+      if constexpr (bounded) {
+        const int rows_left = num_rows - coord_along<axis>(new_coord);
+        const int cols_left = num_cols - new_coord.c;
+        if (!aligned || rows_left < RT::tile_size_row || cols_left < 2 * RT::tile_size_col) {
+          store_acc_tile<true>(dst_ptr, row_stride, v, rows_left, cols_left, aligned);
+          continue;
+        }
+      }
+      store_acc_tile<false>(dst_ptr, row_stride, v);
     }
   }
 }
+#endif
+} // namespace detail
+
+#ifndef KITTENS_EMULATOR
+/**
+ * @brief Stores a column-layout (accumulator) register tile to row-major global memory.
+ *
+ * The accumulator is shuffled across lanes first so that each lane writes 16-byte row segments
+ * instead of 2- or 4-byte column elements. Values are converted to the element type of dst.
+ * The tile must lie entirely within dst; see store_bounded() for tiles that may not.
+ *
+ * @param dst[out] Destination global layout.
+ * @param src[in] Source register tile.
+ * @param idx[in] Coordinate of the tile within dst, in units of the tile.
+ */
+template <int axis, ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void store(GL &dst, const RT &src, const COORD &idx) {
+  detail::store_rt<axis, false>(dst, src, idx);
+}
 
 template <ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD = coord<RT>>
 __device__ inline static void store(GL &dst, const RT &src, const COORD &idx) {
   store<2>(dst, src, idx);
 }
 
-} // namespace kittens
\ No newline at end of file
+/**
+ * @brief Like store(), but elements outside the runtime dimensions of dst are not written.
+ */
+template <int axis, ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void store_bounded(GL &dst, const RT &src, const COORD &idx) {
+  detail::store_rt<axis, true>(dst, src, idx);
+}
+
+template <ducks::gl::all GL, ducks::rt::col_layout RT, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void store_bounded(GL &dst, const RT &src, const COORD &idx) {
+  store_bounded<2>(dst, src, idx);
+}
+#endif
+
+} // namespace kittens
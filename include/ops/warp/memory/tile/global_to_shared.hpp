@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @brief Functions for transferring data directly between global and shared memory.
+ */
+
+#pragma once
+
+#include "../../../../common/common.hpp"
+#include "../../../../types/types.hpp"
+#include "../util/util.hpp"
+
+namespace kittens {
+
+namespace detail {
+
+/**
+ * @brief Registers holding one thread's share of a shared tile while it is in flight from global memory.
+ *
+ * @tparam N_THREADS Number of threads cooperating on the copy.
+ */
+template <int N_THREADS, ducks::st::all ST>
+struct st_prefetch_buffer {
+  static constexpr int num_iters = (ST::num_chunks + N_THREADS - 1) / N_THREADS;
+  int4 chunks[num_iters];
+};
+
+/**
+ * @brief Issues the global reads for a thread's share of a tile, without waiting for them.
+ *
+ * @tparam bounded Zero-fill the parts of the tile outside the runtime dimensions of src.
+ * @param thread[in] Index of the calling thread within the cooperating threads.
+ */
+template <int N_THREADS, int axis, bool bounded, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD>
+__device__ inline void prefetch_st(st_prefetch_buffer<N_THREADS, ST> &buf, const GL &src, const COORD &idx, int thread) {
+  using T = typename ST::dtype;
+  using U = typename GL::dtype;
+  static_assert(std::is_same_v<T, U>, "global to shared loads do not convert types");
+
+  const int row_stride = src.template stride<axis>();
+  const auto origin = idx.template unit_coord<axis, 3>();
+  const U *src_ptr = &src[origin];
+
+  if constexpr (bounded) {
+    const int rows_left = int(src.template shape<axis>()) - coord_along<axis>(origin);
+    const int cols_left = int(src.cols()) - origin.c;
+    const bool aligned = rows_are_chunk_aligned<U>(row_stride);
+    if (!aligned || rows_left < ST::rows || cols_left < ST::cols) {
+#pragma unroll
+      for (int i = 0; i < buf.num_iters; i++) {
+        int chunk = i * N_THREADS + thread;
+        if (ST::num_chunks % N_THREADS == 0 || chunk < ST::num_chunks) {
+          int row = chunk / ST::chunks_per_row;
+          int col = (chunk % ST::chunks_per_row) * ST::elements_per_chunk;
+          buf.chunks[i] = load_chunk_bounded(&src_ptr[row * row_stride + col], row < rows_left ? cols_left - col : 0, aligned);
+        }
+      }
+      return;
+    }
+  }
+
+#pragma unroll
+  for (int i = 0; i < buf.num_iters; i++) {
+    int chunk = i * N_THREADS + thread;
+    if (ST::num_chunks % N_THREADS == 0 || chunk < ST::num_chunks) {
+      int row = chunk / ST::chunks_per_row;
+      int col = (chunk % ST::chunks_per_row) * ST::elements_per_chunk;
+      buf.chunks[i] = *reinterpret_cast<const int4 *>(&src_ptr[row * row_stride + col]);
+    }
+  }
+}
+
+/**
+ * @brief Writes a thread's prefetched share of a tile into shared memory.
+ *
+ * @param thread[in] Index of the calling thread within the cooperating threads; must match the prefetch.
+ */
+template <int N_THREADS, ducks::st::all ST>
+__device__ inline void commit_st(ST &dst, const st_prefetch_buffer<N_THREADS, ST> &buf, int thread) {
+#pragma unroll
+  for (int i = 0; i < buf.num_iters; i++) {
+    int chunk = i * N_THREADS + thread;
+    if (ST::num_chunks % N_THREADS == 0 || chunk < ST::num_chunks) {
+      int row = chunk / ST::chunks_per_row;
+      int col = (chunk % ST::chunks_per_row) * ST::elements_per_chunk;
+      *reinterpret_cast<int4 *>(&dst.data[ST::idx(row, col)]) = buf.chunks[i];
+    }
+  }
+}
+
+/**
+ * @brief Copies a tile from global to shared memory in 16-byte chunks.
+ *
+ * @tparam N_THREADS Number of threads cooperating on the copy.
+ * @param thread[in] Index of the calling thread within the cooperating threads.
+ */
+template <int N_THREADS, int axis, bool bounded, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD>
+__device__ inline void load_st(ST &dst, const GL &src, const COORD &idx, int thread) {
+  st_prefetch_buffer<N_THREADS, ST> buf;
+  prefetch_st<N_THREADS, axis, bounded>(buf, src, idx, thread);
+  commit_st<N_THREADS>(dst, buf, thread);
+}
+
+} // namespace detail
+
+/**
+ * @brief Loads a tile from global memory into shared memory, using the threads of one wave.
+ *
+ * @param dst[out] Destination shared tile.
+ * @param src[in] Source global layout.
+ * @param idx[in] Coordinate of the tile within src, in units of the tile.
+ */
+template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+__device__ inline static void load(ST &dst, const GL &src, const COORD &idx) {
+  detail::load_st<WAVE_THREADS, axis, false>(dst, src, idx, laneid());
+}
+
+template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+__device__ inline static void load(ST &dst, const GL &src, const COORD &idx) {
+  load<2>(dst, src, idx);
+}
+
+/**
+ * @brief Like load(), but elements outside the runtime dimensions of src read as zero.
+ */
+template <int axis, ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+__device__ inline static void load_bounded(ST &dst, const GL &src, const COORD &idx) {
+  detail::load_st<WAVE_THREADS, axis, true>(dst, src, idx, laneid());
+}
+
+template <ducks::st::all ST, ducks::gl::all GL, ducks::coord::tile COORD = coord<ST>>
+__device__ inline static void load_bounded(ST &dst, const GL &src, const COORD &idx) {
+  load_bounded<2>(dst, src, idx);
+}
+
+} // namespace kittens
@@ -0,0 +1,96 @@
+/**
+ * @file
+ * @brief Functions for transferring data directly between shared memory and registers.
+ */
+
+#pragma once
+
+#include "../../../../common/common.hpp"
+#include "../../../../types/types.hpp"
+
+namespace kittens {
+
+/**
+ * @brief Loads a register tile out of a (possibly larger) shared tile.
+ *
+ * Each lane reads the same 8 contiguous elements of its rt_base fragment that a global load would,
+ * as 16-byte LDS reads; with ducks::st_layout::swizzle these are free of bank conflicts.
+ *
+ * @param dst[out] Destination register tile.
+ * @param src[in] Source shared tile.
+ * @param idx[in] Coordinate of dst within src, in units of the register tile.
+ */
+template <ducks::rt::row_layout RT, ducks::st::all ST, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load(RT &dst, const ST &src, const COORD &idx) {
+  using T = typename RT::T;
+  static_assert(std::is_same_v<T, typename ST::dtype>, "shared to register loads do not convert types");
+
+  constexpr int contiguous_elements_to_load = RT::tile_size_col / (WAVE_THREADS / RT::tile_size_row);
+  constexpr int chunks_to_load = contiguous_elements_to_load / ST::elements_per_chunk;
+  static_assert(chunks_to_load >= 1, "each lane must read at least one 16-byte chunk");
+
+  const auto origin = idx.template unit_coord<2, 3>();
+  const int lane = kittens::laneid();
+  const int row_win_tile = lane % RT::tile_size_row;
+  const int col_win_tile = (lane / RT::tile_size_row) * contiguous_elements_to_load;
+
+#pragma unroll
+  for (int row_tile = 0; row_tile < RT::height; row_tile++) {
+#pragma unroll
+    for (int col_tile = 0; col_tile < RT::width; col_tile++) {
+      const int row = origin.r + row_tile * RT::tile_size_row + row_win_tile;
+      const int col = origin.c + col_tile * RT::tile_size_col + col_win_tile;
+      auto reg = reinterpret_cast<int4 *>(dst.tiles[row_tile][col_tile].data);
+#pragma unroll
+      for (int chunk = 0; chunk < chunks_to_load; chunk++) {
+        reg[chunk] = *reinterpret_cast<const int4 *>(&src.data[ST::idx(row, col + chunk * ST::elements_per_chunk)]);
+      }
+    }
+  }
+}
+
+template <ducks::rt::row_layout RT, ducks::st::all ST>
+__device__ inline static void load(RT &dst, const ST &src) {
+  load(dst, src, coord<RT>{0, 0});
+}
+
+/**
+ * @brief Loads a col-layout register tile (the accumulator layout) out of a shared tile, e.g. the K x N operand of mma_AB.
+ *
+ * Each lane reads its column one element at a time; lanes 0-31 cover 32 consecutive elements of a row,
+ * which fall in 16 distinct banks.
+ *
+ * @param dst[out] Destination register tile.
+ * @param src[in] Source shared tile.
+ * @param idx[in] Coordinate of dst within src, in units of the register tile.
+ */
+template <ducks::rt::col_layout RT, ducks::st::all ST, ducks::coord::tile COORD = coord<RT>>
+__device__ inline static void load(RT &dst, const ST &src, const COORD &idx) {
+  using T = typename RT::T;
+  static_assert(std::is_same_v<T, typename ST::dtype>, "shared to register loads do not convert types");
+  static_assert(RT::width % 2 == 0, "RT::width must be even");
+
+  const auto origin = idx.template unit_coord<2, 3>();
+  const int lane = kittens::laneid();
+
+#pragma unroll
+  for (int i = 0; i < RT::height; i++) {
+#pragma unroll
+    for (int j = 0; j < RT::width; j++) {
+      const int col = origin.c + 32 * (j / 2) + lane % 32;
+      T *vals = reinterpret_cast<T *>(dst.tiles[i][j].data);
+#pragma unroll
+      for (int e = 0; e < RT::base_tile::elements_per_thread; e++) {
+        const int row = origin.r + 32 * i + 16 * (j % 2) + 8 * (e / 4) + 4 * (lane / 32) + e % 4;
+        vals[e] = src[{row, col}];
+      }
+    }
+  }
+}
+
+template <ducks::rt::col_layout RT, ducks::st::all ST>
+__device__ inline static void load(RT &dst, const ST &src) {
+  load(dst, src, coord<RT>{0, 0});
+}
+
+} // namespace kittens
@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @brief Helpers shared by the memory ops, mostly for tiles that overhang the edge of a global layout.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "../../../../common/common.hpp"
+#include "../../../../types/types.hpp"
+
+namespace kittens {
+namespace detail {
+
+/**
+ * @brief The component of a unit coordinate along a given axis.
+ */
+template <int axis>
+__device__ inline int coord_along(const coord<ducks::default_type> &idx) {
+  static_assert(axis >= 0 && axis <= 3, "Axis must be 0, 1, 2, or 3.");
+  if constexpr (axis == 0) return idx.b;
+  else if constexpr (axis == 1) return idx.d;
+  else if constexpr (axis == 2) return idx.r;
+  else return idx.c;
+}
+
+/**
+ * @brief Whether every row of a layout can be accessed with 16-byte vector loads and stores.
+ */
+template <typename T>
+__device__ inline bool rows_are_chunk_aligned(int row_stride) {
+  return row_stride % (16 / int(sizeof(T))) == 0;
+}
+
+/**
+ * @brief Reads the 16-byte chunk starting at src, zero-filling elements at or past cols_left.
+ *
+ * Chunks that are entirely in bounds are read with one vector load when aligned is set, the rest
+ * element by element. Nothing at or past cols_left is dereferenced, so rows past the edge of the
+ * layout can simply pass cols_left = 0.
+ */
+template <typename T>
+__device__ inline int4 load_chunk_bounded(const T *src, int cols_left, bool aligned) {
+  constexpr int elements_per_chunk = 16 / sizeof(T);
+  if (aligned && cols_left >= elements_per_chunk) {
+    return *reinterpret_cast<const int4 *>(src);
+  }
+  alignas(16) T vals[elements_per_chunk];
+#pragma unroll
+  for (int e = 0; e < elements_per_chunk; e++) {
+    vals[e] = e < cols_left ? src[e] : base_types::constants<T>::zero();
+  }
+  return *reinterpret_cast<const int4 *>(vals);
+}
+
+/**
+ * @brief Writes the elements of a 16-byte chunk that lie before cols_left; the counterpart of load_chunk_bounded.
+ */
+template <typename T>
+__device__ inline void store_chunk_bounded(T *dst, const int4 &chunk, int cols_left, bool aligned) {
+  constexpr int elements_per_chunk = 16 / sizeof(T);
+  if (aligned && cols_left >= elements_per_chunk) {
+    *reinterpret_cast<int4 *>(dst) = chunk;
+    return;
+  }
+  const T *vals = reinterpret_cast<const T *>(&chunk);
+#pragma unroll
+  for (int e = 0; e < elements_per_chunk; e++) {
+    if (e < cols_left) dst[e] = vals[e];
+  }
+}
+
+} // namespace detail
+} // namespace kittens
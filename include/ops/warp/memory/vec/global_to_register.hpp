@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @brief Functions for transferring data directly between global memory and register vectors and back.
+ */
+
+#pragma once
+
+#include "../../../../common/common.hpp"
+#include "../../../../types/types.hpp"
+
+namespace kittens {
+
+namespace detail {
+
+/**
+ * @brief Loads each lane's share of a register vector, element by element.
+ *
+ * @tparam bounded Elements past the runtime column count of src read as zero.
+ */
+template <bool bounded, ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD>
+__device__ inline void load_rv(RV &dst, const GL &src, const COORD &idx) {
+  using T = typename RV::T;
+  using U = typename GL::dtype;
+  using layout = typename RV::layout;
+
+  const auto origin = idx.template unit_coord<-1, 3>();
+  const U *src_ptr = &src[origin];
+  const int cols_left = bounded ? int(src.cols()) - origin.c : RV::length;
+  const int lane = laneid();
+#pragma unroll
+  for (int o = 0; o < RV::outer_dim; o++) {
+    T *elems = reinterpret_cast<T *>(&dst.data[o][0]);
+#pragma unroll
+    for (int e = 0; e < RV::elements_per_lane; e++) {
+      const int col = o * RV::tile_size + layout::idx(lane, e);
+      elems[e] = !bounded || col < cols_left ? base_types::convertor<T, U>::convert(src_ptr[col]) : base_types::constants<T>::zero();
+    }
+  }
+}
+
+/**
+ * @brief Stores a register vector, with one lane writing each element.
+ *
+ * @tparam bounded Elements past the runtime column count of dst are not written.
+ */
+template <bool bounded, ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD>
+__device__ inline void store_rv(GL &dst, const RV &src, const COORD &idx) {
+  using T = typename RV::T;
+  using U = typename GL::dtype;
+  using layout = typename RV::layout;
+
+  const int lane = laneid();
+  if (!layout::owner(lane)) return;
+  const auto origin = idx.template unit_coord<-1, 3>();
+  U *dst_ptr = &dst[origin];
+  const int cols_left = bounded ? int(dst.cols()) - origin.c : RV::length;
+#pragma unroll
+  for (int o = 0; o < RV::outer_dim; o++) {
+    const T *elems = reinterpret_cast<const T *>(&src.data[o][0]);
+#pragma unroll
+    for (int e = 0; e < RV::elements_per_lane; e++) {
+      const int col = o * RV::tile_size + layout::idx(lane, e);
+      if (!bounded || col < cols_left) dst_ptr[col] = base_types::convertor<U, T>::convert(elems[e]);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Loads data from global memory into a register vector.
+ *
+ * Every lane reads the elements it holds, converted to the element type of dst.
+ *
+ * @param dst[out] Destination register vector.
+ * @param src[in] Source global layout; the vector runs along its columns.
+ * @param idx[in] Coordinate of the vector within src, in units of the vector.
+ */
+template <ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD = coord<RV>>
+__device__ inline static void load(RV &dst, const GL &src, const COORD &idx) {
+  detail::load_rv<false>(dst, src, idx);
+}
+
+/**
+ * @brief Like load(), but elements past the runtime column count of src read as zero.
+ */
+template <ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD = coord<RV>>
+__device__ inline static void load_bounded(RV &dst, const GL &src, const COORD &idx) {
+  detail::load_rv<true>(dst, src, idx);
+}
+
+/**
+ * @brief Stores a register vector to global memory.
+ *
+ * @param dst[out] Destination global layout; the vector runs along its columns.
+ * @param src[in] Source register vector.
+ * @param idx[in] Coordinate of the vector within dst, in units of the vector.
+ */
+template <ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD = coord<RV>>
+__device__ inline static void store(GL &dst, const RV &src, const COORD &idx) {
+  detail::store_rv<false>(dst, src, idx);
+}
+
+/**
+ * @brief Like store(), but elements past the runtime column count of dst are dropped.
+ */
+template <ducks::rv::all RV, ducks::gl::all GL, ducks::coord::vec COORD = coord<RV>>
+__device__ inline static void store_bounded(GL &dst, const RV &src, const COORD &idx) {
+  detail::store_rv<true>(dst, src, idx);
+}
+
+} // namespace kittens
@@ -5,17 +5,194 @@
 
 namespace kittens {
 
-template <int M, int N, int K>
-__device__ inline void mma_ABt(rt_fl<M, N, ducks::rt_layout::col> &c_reg, rt_bf<M, K, ducks::rt_layout::row> const &a_reg, rt_bf<N, K, ducks::rt_layout::row> const &b_reg) {
+#ifndef KITTENS_EMULATOR // MFMA is a cross-lane op; the emulator provides wave-level mma_* instead.
+namespace detail {
+/**
+ * @brief One 32x32x8 MFMA on bf16 or fp16 operands, accumulating in fp32.
+ *
+ * Each operand is the 4 values a lane holds for one k-step, as one 64-bit register pair.
+ */
+template <ducks::base_types::sixteen_bit T, typename CD>
+__device__ inline CD mfma_32x32x8(const int2 &a, const int2 &b, const CD &c) {
+  if constexpr (std::is_same_v<T, bf16>) {
+    using ab_t = __attribute__((__vector_size__(4 * sizeof(short)))) short;
+    return __builtin_amdgcn_mfma_f32_32x32x8bf16_1k(std::bit_cast<ab_t>(a), std::bit_cast<ab_t>(b), c, 0, 0, 0);
+  } else {
+    using ab_t = __attribute__((__vector_size__(4 * sizeof(_Float16)))) _Float16;
+    return __builtin_amdgcn_mfma_f32_32x32x8f16(std::bit_cast<ab_t>(a), std::bit_cast<ab_t>(b), c, 0, 0, 0);
+  }
+}
+
+/**
+ * @brief The operands a lane feeds the two 32x32x8 k-steps covering k-tile kt of one 32-wide block of an MMA input.
+ *
+ * A row-layout tile stores the block as outer x K, and base tile (outer, kt) already holds the 8 k values
+ * 8 * (laneid / 32) + [0, 8) of its row, in step order. A col-layout tile stores it as K x outer, in the
+ * accumulator order: k-tile kt is base tile (kt / 2, 2 * outer + kt % 2), whose lane holds k values
+ * 4 * (laneid / 32) + [0, 4) and 8 + 4 * (laneid / 32) + [0, 4) of its column. Each lane swaps the half the
+ * other half-wave needs with lane ^ 32, which puts both layouts in the same k order.
+ *
+ * @param frag[out] Operand of k-step 0 and of k-step 1.
+ * @param src[in] Row-layout tile (outer x K) or col-layout tile (K x outer).
+ * @param outer[in] Block of 32 rows (row layout) or columns (col layout).
+ * @param kt[in] k-tile, 16 wide.
+ */
+template <ducks::rt::all RT>
+__device__ inline void mma_operand(int2 (&frag)[2], const RT &src, int outer, int kt) {
+  if constexpr (std::is_same_v<typename RT::layout, ducks::rt_layout::row>) {
+    const int2 *words = reinterpret_cast<const int2 *>(src.tiles[outer][kt].data);
+    frag[0] = words[0];
+    frag[1] = words[1];
+  } else {
+    const int2 *words = reinterpret_cast<const int2 *>(src.tiles[kt / 2][2 * outer + kt % 2].data);
+    const bool upper = kittens::laneid() >= 32;
+    const int2 received = butterfly<32>(upper ? words[0] : words[1]);
+    frag[0] = upper ? received : words[0];
+    frag[1] = upper ? words[1] : received;
+  }
+}
+
+/**
+ * @brief Accumulates C += op(A) * op(B) with 32x32x8 MFMAs, where op transposes col-layout inputs.
+ *
+ * An fp16 accumulator is widened to fp32 for the call and rounded back once at the end.
+ */
+template <ducks::rt::col_layout CT, ducks::rt::all AT, ducks::rt::all BT>
+__device__ inline void mma(CT &c_reg, const AT &a_reg, const BT &b_reg) {
+  constexpr bool trans_a = std::is_same_v<typename AT::layout, ducks::rt_layout::col>;
+  constexpr bool trans_b = std::is_same_v<typename BT::layout, ducks::rt_layout::row>;
+  constexpr int M = CT::rows, N = CT::cols;
+  constexpr int K = trans_a ? AT::rows : AT::cols;
+  static_assert((trans_a ? AT::cols : AT::rows) == M, "A does not have M rows");
+  static_assert((trans_b ? BT::rows : BT::cols) == N, "B does not have N columns");
+  static_assert((trans_b ? BT::cols : BT::rows) == K, "A and B disagree on K");
+  static_assert(std::is_same_v<typename AT::T, typename BT::T>, "A and B must have the same element type");
+  static_assert(M % 32 == 0 && N % 32 == 0, "M and N must be divisible by 32");
+  static_assert(K % 16 == 0, "K must be divisible by 16");
+
+  if constexpr (std::is_same_v<typename CT::T, half>) {
+    rt_fl<M, N, ducks::rt_layout::col> acc;
+    acc = c_reg;
+    mma(acc, a_reg, b_reg);
+    c_reg = acc;
+  } else {
+    static_assert(std::is_same_v<typename CT::T, float>, "accumulators must be fp32 or fp16");
+    using cd_t = __attribute__((__vector_size__(16 * sizeof(float)))) float;
+    constexpr int M_tiles = M / 32;
+    constexpr int N_tiles = N / 32;
+    constexpr int K_tiles = K / 16;
+
+#pragma unroll
+    for (int k = 0; k < K_tiles; k++) {
+      // Gather B once per k-tile; for a col-layout B this is where its half-wave swap happens
+      int2 b_frag[N_tiles][2];
+#pragma unroll
+      for (int n = 0; n < N_tiles; n++) mma_operand(b_frag[n], b_reg, n, k);
+#pragma unroll
+      for (int m = 0; m < M_tiles; m++) {
+        int2 a_frag[2];
+        mma_operand(a_frag, a_reg, m, k);
+#pragma unroll
+        for (int n = 0; n < N_tiles; n++) {
+          // Each 32x32 accumulator spans two adjacent 32x16 col-layout base tiles
+          auto &c = reinterpret_cast<cd_t &>(c_reg.tiles[m][2 * n].data[0]);
+          c = mfma_32x32x8<typename AT::T>(a_frag[0], b_frag[n][0], c);
+          c = mfma_32x32x8<typename AT::T>(a_frag[1], b_frag[n][1], c);
+        }
+      }
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Accumulates C += A * B with 32x32x8 MFMAs.
+ *
+ * A and B are bf16 or fp16, C is fp32 or fp16. B is held K x N in col layout, as loaded from a row-major
+ * K x N matrix or converted from an accumulator, so weights stored K x N need no transposing pass.
+ *
+ * @param c_reg[in,out] Accumulator tile, M x N.
+ * @param a_reg[in] Row-layout tile, M x K.
+ * @param b_reg[in] Col-layout tile, K x N.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+__device__ inline void mma_AB(rt<TC, M, N, ducks::rt_layout::col> &c_reg, rt<T, M, K, ducks::rt_layout::row> const &a_reg, rt<T, K, N, ducks::rt_layout::col> const &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Accumulates C += A * B^T with 32x32x8 MFMAs; the layout combination that needs no lane exchange.
+ *
+ * @param c_reg[in,out] Accumulator tile, M x N.
+ * @param a_reg[in] Row-layout tile, M x K.
+ * @param b_reg[in] Row-layout tile, N x K.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+__device__ inline void mma_ABt(rt<TC, M, N, ducks::rt_layout::col> &c_reg, rt<T, M, K, ducks::rt_layout::row> const &a_reg, rt<T, N, K, ducks::rt_layout::row> const &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Accumulates C += A^T * B with 32x32x8 MFMAs.
+ *
+ * @param c_reg[in,out] Accumulator tile, M x N.
+ * @param a_reg[in] Col-layout tile, K x M.
+ * @param b_reg[in] Col-layout tile, K x N.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+__device__ inline void mma_AtB(rt<TC, M, N, ducks::rt_layout::col> &c_reg, rt<T, K, M, ducks::rt_layout::col> const &a_reg, rt<T, K, N, ducks::rt_layout::col> const &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+/**
+ * @brief Accumulates C += A^T * B^T with 32x32x8 MFMAs.
+ *
+ * @param c_reg[in,out] Accumulator tile, M x N.
+ * @param a_reg[in] Col-layout tile, K x M.
+ * @param b_reg[in] Row-layout tile, N x K.
+ */
+template <int M, int N, int K, ducks::base_types::sixteen_bit T, typename TC>
+__device__ inline void mma_AtBt(rt<TC, M, N, ducks::rt_layout::col> &c_reg, rt<T, K, M, ducks::rt_layout::col> const &a_reg, rt<T, N, K, ducks::rt_layout::row> const &b_reg) {
+  detail::mma(c_reg, a_reg, b_reg);
+}
+
+namespace detail {
+/**
+ * @brief One 32x32x16 fp8 MFMA, picking the instruction for the element formats of A and B.
+ *
+ * Each operand is the 8 fp8 values a lane holds for one k-step, as one 64-bit register pair.
+ */
+template <ducks::base_types::fp8 TA, ducks::base_types::fp8 TB, typename CD>
+__device__ inline CD mfma_32x32x16_fp8(long a, long b, const CD &c) {
+  if constexpr (std::is_same_v<TA, fp8e4m3> && std::is_same_v<TB, fp8e4m3>) {
+    return __builtin_amdgcn_mfma_f32_32x32x16_fp8_fp8(a, b, c, 0, 0, 0);
+  } else if constexpr (std::is_same_v<TA, fp8e4m3>) {
+    return __builtin_amdgcn_mfma_f32_32x32x16_fp8_bf8(a, b, c, 0, 0, 0);
+  } else if constexpr (std::is_same_v<TB, fp8e4m3>) {
+    return __builtin_amdgcn_mfma_f32_32x32x16_bf8_fp8(a, b, c, 0, 0, 0);
+  } else {
+    return __builtin_amdgcn_mfma_f32_32x32x16_bf8_bf8(a, b, c, 0, 0, 0);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Accumulates C += A * B^T with 32x32x16 fp8 MFMAs.
+ *
+ * A and B may each be e4m3 or e5m2. fp8 base tiles are 32x32, so K may span any number of 32-wide base tiles,
+ * each issued as two k-steps exactly like the bf16 path. Scaling is left to the caller: multiply C by the
+ * product of the dequantization scales of A and B once the accumulation is done.
+ *
+ * @param c_reg[in,out] fp32 accumulator tile, M x N.
+ * @param a_reg[in] fp8 tile, M x K.
+ * @param b_reg[in] fp8 tile, N x K.
+ */
+template <int M, int N, int K, ducks::base_types::fp8 TA, ducks::base_types::fp8 TB>
+__device__ inline void mma_ABt(rt_fl<M, N, ducks::rt_layout::col> &c_reg, rt<TA, M, K, ducks::rt_layout::row> const &a_reg, rt<TB, N, K, ducks::rt_layout::row> const &b_reg) {
   static_assert(M % 32 == 0, "M must be divisible by 32");
   static_assert(N % 32 == 0, "N must be divisible by 32");
-  static_assert(K % 16 == 0, "K must be divisible by 16");
+  static_assert(K % 32 == 0, "K must be divisible by 32");
 
   constexpr int M_tiles = M / 32;
   constexpr int N_tiles = N / 32;
-  constexpr int K_tiles = K / 16;
-
-  static_assert(K_tiles == 1, "K must be 1 (FOR NOW)");
+  constexpr int K_tiles = K / 32;
 
 #pragma unroll
   for (int m = 0; m < M_tiles; m++) {
@@ -23,21 +200,17 @@ __device__ inline void mma_ABt(rt_fl<M, N, ducks::rt_layout::col> &c_reg, rt_bf<
     for (int n = 0; n < N_tiles; n++) {
 #pragma unroll
       for (int k = 0; k < K_tiles; k++) {
-        // Decompose the MNK=32x32x16 matmuls into two 32x32x8 matmuls that accumulate into the same registers
-        using ab_t = __attribute__((__vector_size__(4 * sizeof(short)))) short const;
         using cd_t = __attribute__((__vector_size__(16 * sizeof(float)))) float;
-        auto &c = reinterpret_cast<cd_t &>(c_reg.tiles[m][n].data[0]);
-
-        auto &a1 = reinterpret_cast<ab_t const &>(a_reg.tiles[m][k].data[0]);
-        auto &b1 = reinterpret_cast<ab_t const &>(b_reg.tiles[n][k].data[0]);
-        c = __builtin_amdgcn_mfma_f32_32x32x8bf16_1k(a1, b1, c, 0, 0, 0);
-
-        auto &a2 = reinterpret_cast<ab_t const &>(a_reg.tiles[m][k].data[a_reg.packed_per_thread / 2]);
-        auto &b2 = reinterpret_cast<ab_t const &>(b_reg.tiles[n][k].data[b_reg.packed_per_thread / 2]);
-        c = __builtin_amdgcn_mfma_f32_32x32x8bf16_1k(a2, b2, c, 0, 0, 0);
+        auto &c = reinterpret_cast<cd_t &>(c_reg.tiles[m][2 * n].data[0]);
+        auto a = reinterpret_cast<const long *>(a_reg.tiles[m][k].data);
+        auto b = reinterpret_cast<const long *>(b_reg.tiles[n][k].data);
+        // Each lane holds 16 contiguous k values of its row; the two halves are consecutive 32x32x16 steps
+        c = detail::mfma_32x32x16_fp8<TA, TB>(a[0], b[0], c);
+        c = detail::mfma_32x32x16_fp8<TA, TB>(a[1], b[1], c);
       }
     }
   }
 }
+#endif
 
 } // namespace kittens
\ No newline at end of file
@@ -105,29 +105,27 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param src[in] Source tile to apply the operation on.
  * @param row_values[in] Column vector containing values to apply across each row.
  */
-// template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
-// __device__ static inline void row_map(T &dst, const T &src, const V &row_values) {
-
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::height);                                                                               // compatible size
-
-//   using dtype = T::dtype;
-
-// #pragma unroll
-//   for (int i = 0; i < dst.height; i++) {
-//     dtype packed_top_row = base_types::packing<dtype>::pack(row_values[i][0].x);    //  first value in eager mode
-//     dtype packed_bottom_row = base_types::packing<dtype>::pack(row_values[i][0].y); // second value in eager mode
-// #pragma unroll
-//     for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile; k += 2) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(src.tiles[i][j].data[k + 0], packed_top_row);
-//         dst.tiles[i][j].data[k + 1] = op::template op<dtype>(src.tiles[i][j].data[k + 1], packed_bottom_row);
-//       }
-//     }
-//   }
-// }
+template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
+__device__ static inline void row_map(T &dst, const T &src, const V &row_values) {
+
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::rows);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+
+#pragma unroll
+  for (int i = 0; i < dst.height; i++) {
+    dtype packed_row = base_types::packing<dtype>::pack(row_values[i][0]); // each lane owns a single row of each tile
+#pragma unroll
+    for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(src.tiles[i][j].data[k], packed_row);
+      }
+    }
+  }
+}
 /**
  * @brief Applies an operation across the rows of a tile in a column-major layout.
  *
@@ -138,27 +136,27 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param src[in] Source tile to apply the operation on.
  * @param row_values[in] Column vector containing values to apply across each row.
  */
-// template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
-// __device__ static inline void row_map(T &dst, const T &src, const V &row_values) {
+template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
+__device__ static inline void row_map(T &dst, const T &src, const V &row_values) {
 
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
-//   static_assert(V::outer_dim == T::height);                                                                               // compatible size
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(V::length == T::rows);                                                                                    // compatible size
 
-//   using dtype = T::dtype;
+  using dtype = T::dtype;
 
-// #pragma unroll
-//   for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//     for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile / 2; k++) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(src.tiles[i][j].data[k + 0], row_values[i][0]);
-//         dst.tiles[i][j].data[k + 2] = op::template op<dtype>(src.tiles[i][j].data[k + 2], row_values[i][1]);
-//       }
-//     }
-//   }
-// }
+#pragma unroll
+  for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+    for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        // odd base tiles hold the bottom 16 rows of their 32x32 accumulator
+        dst.tiles[i][j].data[k] = op::template op<dtype>(src.tiles[i][j].data[k], row_values[i][(j % 2) * dst.packed_per_tile + k]);
+      }
+    }
+  }
+}
 
 // Three-operand row map. Mostly useful for FMA instructions.
 
@@ -173,29 +171,27 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param b[in] Second source tile to apply the operation on.
  * @param row_values[in] Column vector containing values to apply across each row.
  */
-// template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
-// __device__ static inline void row_map(T &dst, const T &a, const T &b, const V &row_values) {
-
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::height);                                                                               // compatible size
-
-//   using dtype = T::dtype;
-
-// #pragma unroll
-//   for (int i = 0; i < dst.height; i++) {
-//     dtype packed_top_row = base_types::packing<dtype>::pack(row_values[i][0].x);    //  first value in eager mode
-//     dtype packed_bottom_row = base_types::packing<dtype>::pack(row_values[i][0].y); // second value in eager mode
-// #pragma unroll
-//     for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile; k += 2) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(a.tiles[i][j].data[k + 0], b.tiles[i][j].data[k + 0], packed_top_row);
-//         dst.tiles[i][j].data[k + 1] = op::template op<dtype>(a.tiles[i][j].data[k + 1], b.tiles[i][j].data[k + 1], packed_bottom_row);
-//       }
-//     }
-//   }
-// }
+template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
+__device__ static inline void row_map(T &dst, const T &a, const T &b, const V &row_values) {
+
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::rows);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+
+#pragma unroll
+  for (int i = 0; i < dst.height; i++) {
+    dtype packed_row = base_types::packing<dtype>::pack(row_values[i][0]); // each lane owns a single row of each tile
+#pragma unroll
+    for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(a.tiles[i][j].data[k], b.tiles[i][j].data[k], packed_row);
+      }
+    }
+  }
+}
 /**
  * @brief Applies an operation across the rows of two tiles in a column-major layout, using a third operand.
  *
@@ -207,27 +203,26 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param b[in] Second source tile to apply the operation on.
  * @param row_values[in] Column vector containing values to apply across each row.
  */
-// template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
-// __device__ static inline void row_map(T &dst, const T &a, const T &b, const V &row_values) {
+template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
+__device__ static inline void row_map(T &dst, const T &a, const T &b, const V &row_values) {
 
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::height);                                                                               // compatible size
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(V::length == T::rows);                                                                                    // compatible size
 
-//   using dtype = T::dtype;
+  using dtype = T::dtype;
 
-// #pragma unroll
-//   for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//     for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile / 2; k++) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(a.tiles[i][j].data[k + 0], b.tiles[i][j].data[k + 0], row_values[i][0]);
-//         dst.tiles[i][j].data[k + 2] = op::template op<dtype>(a.tiles[i][j].data[k + 2], b.tiles[i][j].data[k + 2], row_values[i][1]);
-//       }
-//     }
-//   }
-// }
+#pragma unroll
+  for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+    for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(a.tiles[i][j].data[k], b.tiles[i][j].data[k], row_values[i][(j % 2) * dst.packed_per_tile + k]);
+      }
+    }
+  }
+}
 
 /* ----------  Col major tile maps  ----------*/
 
@@ -241,27 +236,26 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param src[in] Source tile to apply the operation on.
  * @param col_values[in] Row vector containing values to apply across each column.
  */
-// template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
-// __device__ static inline void col_map(T &dst, const T &src, const V &col_values) {
+template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
+__device__ static inline void col_map(T &dst, const T &src, const V &col_values) {
 
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::width);                                                                                // compatible size
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::cols);                                                                                    // compatible size
 
-//   using dtype = T::dtype;
+  using dtype = T::dtype;
 
-// #pragma unroll
-//   for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//     for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile / 2; k++) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(src.tiles[i][j].data[k + 0], col_values[j][0]);
-//         dst.tiles[i][j].data[k + 2] = op::template op<dtype>(src.tiles[i][j].data[k + 2], col_values[j][1]);
-//       }
-//     }
-//   }
-// }
+#pragma unroll
+  for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+    for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(src.tiles[i][j].data[k], col_values[j][k]);
+      }
+    }
+  }
+}
 /**
  * @brief Applies an operation across the columns of a tile in a column-major layout.
  *
@@ -272,29 +266,27 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param src[in] Source tile to apply the operation on.
  * @param col_values[in] Row vector containing values to apply across each column.
  */
-// template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
-// __device__ static inline void col_map(T &dst, const T &src, const V &col_values) {
-
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::width);                                                                                // compatible size
-
-//   using dtype = T::dtype;
-
-// #pragma unroll
-//   for (int j = 0; j < dst.width; j++) {
-//     dtype packed_left_col = base_types::packing<dtype>::pack(col_values[j][0].x);  //  first value in eager mode
-//     dtype packed_right_col = base_types::packing<dtype>::pack(col_values[j][0].y); // second value in eager mode
-// #pragma unroll
-//     for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile; k += 2) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(src.tiles[i][j].data[k + 0], packed_left_col);
-//         dst.tiles[i][j].data[k + 1] = op::template op<dtype>(src.tiles[i][j].data[k + 1], packed_right_col);
-//       }
-//     }
-//   }
-// }
+template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
+__device__ static inline void col_map(T &dst, const T &src, const V &col_values) {
+
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::cols);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+
+#pragma unroll
+  for (int j = 0; j < dst.width; j++) {
+    dtype packed_col = base_types::packing<dtype>::pack(col_values[j / 2][0]); // each lane owns a single column of each 32x32 accumulator
+#pragma unroll
+    for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(src.tiles[i][j].data[k], packed_col);
+      }
+    }
+  }
+}
 
 // Three-operand col map
 /**
@@ -308,27 +300,26 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param b[in] Second source tile to apply the operation on.
  * @param col_values[in] Row vector containing values to apply across each column.
  */
-// template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
-// __device__ static inline void col_map(T &dst, const T &a, const T &b, const V &col_values) {
+template <typename op, ducks::rt::row_layout T, ducks::rv::all V>
+__device__ static inline void col_map(T &dst, const T &a, const T &b, const V &col_values) {
 
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(V::outer_dim == T::width);                                                                                // compatible size
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::cols);                                                                                    // compatible size
 
-//   using dtype = T::dtype;
+  using dtype = T::dtype;
 
-// #pragma unroll
-//   for (int j = 0; j < dst.width; j++) {
-// #pragma unroll
-//     for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile / 2; k++) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(a.tiles[i][j].data[k + 0], b.tiles[i][j].data[k + 0], col_values[j][0]);
-//         dst.tiles[i][j].data[k + 2] = op::template op<dtype>(a.tiles[i][j].data[k + 2], b.tiles[i][j].data[k + 2], col_values[j][1]);
-//       }
-//     }
-//   }
-// }
+#pragma unroll
+  for (int j = 0; j < dst.width; j++) {
+#pragma unroll
+    for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(a.tiles[i][j].data[k], b.tiles[i][j].data[k], col_values[j][k]);
+      }
+    }
+  }
+}
 /**
  * @brief Applies an operation across the columns of two tiles in a column-major layout, using a third operand.
  *
@@ -340,28 +331,26 @@ __device__ static inline void bin_map(T &dst, const T &lhs, const T &rhs) {
  * @param b[in] Second source tile to apply the operation on.
  * @param col_values[in] Row vector containing values to apply across each column.
  */
-// template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
-// __device__ static inline void col_map(T &dst, const T &a, const T &b, const V &col_values) {
-
-//   static_assert(std::is_same_v<typename V::dtype, typename T::dtype>);                                                    // compatible type
-//   static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
-//   static_assert(V::outer_dim == T::width);                                                                                // compatible size
-
-//   using dtype = T::dtype;
-// #pragma unroll
-//   for (int j = 0; j < dst.width; j++) {
-//     dtype packed_left_col = base_types::packing<dtype>::pack(col_values[j][0].x);  //  first value in eager mode
-//     dtype packed_right_col = base_types::packing<dtype>::pack(col_values[j][0].y); // second value in eager mode
-// #pragma unroll
-//     for (int i = 0; i < dst.height; i++) {
-// #pragma unroll
-//       for (int k = 0; k < dst.packed_per_tile; k += 2) {
-//         dst.tiles[i][j].data[k + 0] = op::template op<dtype>(a.tiles[i][j].data[k + 0], b.tiles[i][j].data[k + 0], packed_left_col);
-//         dst.tiles[i][j].data[k + 1] = op::template op<dtype>(a.tiles[i][j].data[k + 1], b.tiles[i][j].data[k + 1], packed_right_col);
-//       }
-//     }
-//   }
-// }
+template <typename op, ducks::rt::col_layout T, ducks::rv::all V>
+__device__ static inline void col_map(T &dst, const T &a, const T &b, const V &col_values) {
+
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(V::length == T::cols);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+#pragma unroll
+  for (int j = 0; j < dst.width; j++) {
+    dtype packed_col = base_types::packing<dtype>::pack(col_values[j / 2][0]); // each lane owns a single column of each 32x32 accumulator
+#pragma unroll
+    for (int i = 0; i < dst.height; i++) {
+#pragma unroll
+      for (int k = 0; k < dst.packed_per_tile; k++) {
+        dst.tiles[i][j].data[k] = op::template op<dtype>(a.tiles[i][j].data[k], b.tiles[i][j].data[k], packed_col);
+      }
+    }
+  }
+}
 
 /* ----------  WRAPPERS FOR PRETTINESS  ---------- */
 
@@ -666,315 +655,315 @@ __device__ static inline void operator/=(T &lhs, const U &rhs) {
   div(lhs, lhs, rhs);
 }
 
-// /**
-//  * @brief Adds row values to each row of a tile.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Column vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the addition on.
-//  * @param row_values[in] Column vector containing values to add to each row.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void add_row(T &dst, const T &src, const V &row_values) {
-//   row_map<base_ops::sum, T, V>(dst, src, row_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator+(const T &src, const V &row_values) {
-//   T dst;
-//   add_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator+(const T &src, const V &row_values) {
-//   T dst;
-//   add_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator+=(T &lhs, const V &row_values) {
-//   add_row(lhs, lhs, row_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator+=(T &lhs, const V &row_values) {
-//   add_row(lhs, lhs, row_values);
-// }
-
-// /**
-//  * @brief Subtracts row values from each row of a tile.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Column vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the subtraction on.
-//  * @param row_values[in] Column vector containing values to subtract from each row.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void sub_row(T &dst, const T &src, const V &row_values) {
-//   row_map<base_ops::sub, T, V>(dst, src, row_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator-(const T &src, const V &row_values) {
-//   T dst;
-//   sub_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator-(const T &src, const V &row_values) {
-//   T dst;
-//   sub_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator-=(T &lhs, const V &row_values) {
-//   sub_row(lhs, lhs, row_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator-=(T &lhs, const V &row_values) {
-//   sub_row(lhs, lhs, row_values);
-// }
-
-// /**
-//  * @brief Multiplies each row of a tile by row values.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Column vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the multiplication on.
-//  * @param row_values[in] Column vector containing values to multiply each row by.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void mul_row(T &dst, const T &src, const V &row_values) {
-//   row_map<base_ops::mul, T, V>(dst, src, row_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator*(const T &src, const V &row_values) {
-//   T dst;
-//   mul_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator*(const T &src, const V &row_values) {
-//   T dst;
-//   mul_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator*=(T &lhs, const V &row_values) {
-//   mul_row(lhs, lhs, row_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator*=(T &lhs, const V &row_values) {
-//   mul_row(lhs, lhs, row_values);
-// }
-
-// /**
-//  * @brief Divides each row of a tile by row values.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Column vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the division on.
-//  * @param row_values[in] Column vector containing values to divide each row by.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void div_row(T &dst, const T &src, const V &row_values) {
-//   row_map<base_ops::div, T, V>(dst, src, row_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator/(const T &src, const V &row_values) {
-//   T dst;
-//   div_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator/(const T &src, const V &row_values) {
-//   T dst;
-//   div_row(dst, src, row_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator/=(T &lhs, const V &row_values) {
-//   div_row(lhs, lhs, row_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator/=(T &lhs, const V &row_values) {
-//   div_row(lhs, lhs, row_values);
-// }
-
-// /**
-//  * @brief Broadcast a vector into into a tile's rows.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Column vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param row_values[in] Column vector containing values to broadcast into rows.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void broadcast_row(T &dst, const V &row_values) {
-//   row_map<base_ops::copy2, T, V>(dst, dst, row_values);
-// }
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline T broadcast_row(const V &row_values) {
-//   T dst;
-//   broadcast_row(dst, row_values);
-//   return dst;
-// }
-
-// // col maps
-// /**
-//  * @brief Adds column values to each column of a tile.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Row vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the addition on.
-//  * @param col_values[in] Row vector containing values to add to each column.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void add_col(T &dst, const T &src, const V &col_values) {
-//   col_map<base_ops::sum, T, V>(dst, src, col_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator+(const T &src, const V &col_values) {
-//   T dst;
-//   add_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator+(const T &src, const V &col_values) {
-//   T dst;
-//   add_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator+=(T &lhs, const V &col_values) {
-//   add_col(lhs, lhs, col_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator+=(T &lhs, const V &col_values) {
-//   add_col(lhs, lhs, col_values);
-// }
-
-// /**
-//  * @brief Subtracts column values from each column of a tile.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Row vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the subtraction on.
-//  * @param col_values[in] Row vector containing values to subtract from each column.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void sub_col(T &dst, const T &src, const V &col_values) {
-//   col_map<base_ops::sub, T, V>(dst, src, col_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator-(const T &src, const V &col_values) {
-//   T dst;
-//   sub_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator-(const T &src, const V &col_values) {
-//   T dst;
-//   sub_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator-=(T &lhs, const V &col_values) {
-//   sub_col(lhs, lhs, col_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator-=(T &lhs, const V &col_values) {
-//   sub_col(lhs, lhs, col_values);
-// }
-
-// /**
-//  * @brief Multiplies each column of a tile by column values.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Row vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the multiplication on.
-//  * @param col_values[in] Row vector containing values to multiply each column by.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void mul_col(T &dst, const T &src, const V &col_values) {
-//   col_map<base_ops::mul, T, V>(dst, src, col_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator*(const T &src, const V &col_values) {
-//   T dst;
-//   mul_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator*(const T &src, const V &col_values) {
-//   T dst;
-//   mul_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator*=(T &lhs, const V &col_values) {
-//   mul_col(lhs, lhs, col_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator*=(T &lhs, const V &col_values) {
-//   mul_col(lhs, lhs, col_values);
-// }
-
-// /**
-//  * @brief Divides each column of a tile by column values.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Row vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param src[in] Source tile to apply the division on.
-//  * @param col_values[in] Row vector containing values to divide each column by.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void div_col(T &dst, const T &src, const V &col_values) {
-//   col_map<base_ops::div, T, V>(dst, src, col_values);
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline T operator/(const T &src, const V &col_values) {
-//   T dst;
-//   div_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline T operator/(const T &src, const V &col_values) {
-//   T dst;
-//   div_col(dst, src, col_values);
-//   return dst;
-// }
-// template <ducks::rt::row_layout T, ducks::rv::align_layout V>
-// __device__ static inline void operator/=(T &lhs, const V &col_values) {
-//   div_col(lhs, lhs, col_values);
-// }
-// template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
-// __device__ static inline void operator/=(T &lhs, const V &col_values) {
-//   div_col(lhs, lhs, col_values);
-// }
-
-// /**
-//  * @brief Broadcast a vector into into a tile's columns.
-//  *
-//  * @tparam T Tile type.
-//  * @tparam V Row vector type.
-//  * @param dst[out] Destination tile where the result is stored.
-//  * @param row_values[in] Row vector containing values to broadcast into cols.
-//  */
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline void broadcast_col(T &dst, const V &col_values) {
-//   col_map<base_ops::copy2, T, V>(dst, dst, col_values);
-// }
-// template <ducks::rt::all T, ducks::rv::all V>
-// __device__ static inline T broadcast_col(const V &col_values) {
-//   T dst;
-//   broadcast_col(dst, col_values);
-//   return dst;
-// }
+/**
+ * @brief Adds row values to each row of a tile.
+ *
+ * @tparam T Tile type.
+ * @tparam V Column vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the addition on.
+ * @param row_values[in] Column vector containing values to add to each row.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void add_row(T &dst, const T &src, const V &row_values) {
+  row_map<base_ops::sum, T, V>(dst, src, row_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator+(const T &src, const V &row_values) {
+  T dst;
+  add_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator+(const T &src, const V &row_values) {
+  T dst;
+  add_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator+=(T &lhs, const V &row_values) {
+  add_row(lhs, lhs, row_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator+=(T &lhs, const V &row_values) {
+  add_row(lhs, lhs, row_values);
+}
+
+/**
+ * @brief Subtracts row values from each row of a tile.
+ *
+ * @tparam T Tile type.
+ * @tparam V Column vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the subtraction on.
+ * @param row_values[in] Column vector containing values to subtract from each row.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void sub_row(T &dst, const T &src, const V &row_values) {
+  row_map<base_ops::sub, T, V>(dst, src, row_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator-(const T &src, const V &row_values) {
+  T dst;
+  sub_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator-(const T &src, const V &row_values) {
+  T dst;
+  sub_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator-=(T &lhs, const V &row_values) {
+  sub_row(lhs, lhs, row_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator-=(T &lhs, const V &row_values) {
+  sub_row(lhs, lhs, row_values);
+}
+
+/**
+ * @brief Multiplies each row of a tile by row values.
+ *
+ * @tparam T Tile type.
+ * @tparam V Column vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the multiplication on.
+ * @param row_values[in] Column vector containing values to multiply each row by.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void mul_row(T &dst, const T &src, const V &row_values) {
+  row_map<base_ops::mul, T, V>(dst, src, row_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator*(const T &src, const V &row_values) {
+  T dst;
+  mul_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator*(const T &src, const V &row_values) {
+  T dst;
+  mul_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator*=(T &lhs, const V &row_values) {
+  mul_row(lhs, lhs, row_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator*=(T &lhs, const V &row_values) {
+  mul_row(lhs, lhs, row_values);
+}
+
+/**
+ * @brief Divides each row of a tile by row values.
+ *
+ * @tparam T Tile type.
+ * @tparam V Column vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the division on.
+ * @param row_values[in] Column vector containing values to divide each row by.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void div_row(T &dst, const T &src, const V &row_values) {
+  row_map<base_ops::div, T, V>(dst, src, row_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator/(const T &src, const V &row_values) {
+  T dst;
+  div_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator/(const T &src, const V &row_values) {
+  T dst;
+  div_row(dst, src, row_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator/=(T &lhs, const V &row_values) {
+  div_row(lhs, lhs, row_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator/=(T &lhs, const V &row_values) {
+  div_row(lhs, lhs, row_values);
+}
+
+/**
+ * @brief Broadcast a vector into into a tile's rows.
+ *
+ * @tparam T Tile type.
+ * @tparam V Column vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param row_values[in] Column vector containing values to broadcast into rows.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void broadcast_row(T &dst, const V &row_values) {
+  row_map<base_ops::copy2, T, V>(dst, dst, row_values);
+}
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline T broadcast_row(const V &row_values) {
+  T dst;
+  broadcast_row(dst, row_values);
+  return dst;
+}
+
+// col maps
+/**
+ * @brief Adds column values to each column of a tile.
+ *
+ * @tparam T Tile type.
+ * @tparam V Row vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the addition on.
+ * @param col_values[in] Row vector containing values to add to each column.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void add_col(T &dst, const T &src, const V &col_values) {
+  col_map<base_ops::sum, T, V>(dst, src, col_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator+(const T &src, const V &col_values) {
+  T dst;
+  add_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator+(const T &src, const V &col_values) {
+  T dst;
+  add_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator+=(T &lhs, const V &col_values) {
+  add_col(lhs, lhs, col_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator+=(T &lhs, const V &col_values) {
+  add_col(lhs, lhs, col_values);
+}
+
+/**
+ * @brief Subtracts column values from each column of a tile.
+ *
+ * @tparam T Tile type.
+ * @tparam V Row vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the subtraction on.
+ * @param col_values[in] Row vector containing values to subtract from each column.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void sub_col(T &dst, const T &src, const V &col_values) {
+  col_map<base_ops::sub, T, V>(dst, src, col_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator-(const T &src, const V &col_values) {
+  T dst;
+  sub_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator-(const T &src, const V &col_values) {
+  T dst;
+  sub_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator-=(T &lhs, const V &col_values) {
+  sub_col(lhs, lhs, col_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator-=(T &lhs, const V &col_values) {
+  sub_col(lhs, lhs, col_values);
+}
+
+/**
+ * @brief Multiplies each column of a tile by column values.
+ *
+ * @tparam T Tile type.
+ * @tparam V Row vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the multiplication on.
+ * @param col_values[in] Row vector containing values to multiply each column by.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void mul_col(T &dst, const T &src, const V &col_values) {
+  col_map<base_ops::mul, T, V>(dst, src, col_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator*(const T &src, const V &col_values) {
+  T dst;
+  mul_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator*(const T &src, const V &col_values) {
+  T dst;
+  mul_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator*=(T &lhs, const V &col_values) {
+  mul_col(lhs, lhs, col_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator*=(T &lhs, const V &col_values) {
+  mul_col(lhs, lhs, col_values);
+}
+
+/**
+ * @brief Divides each column of a tile by column values.
+ *
+ * @tparam T Tile type.
+ * @tparam V Row vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param src[in] Source tile to apply the division on.
+ * @param col_values[in] Row vector containing values to divide each column by.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void div_col(T &dst, const T &src, const V &col_values) {
+  col_map<base_ops::div, T, V>(dst, src, col_values);
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline T operator/(const T &src, const V &col_values) {
+  T dst;
+  div_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline T operator/(const T &src, const V &col_values) {
+  T dst;
+  div_col(dst, src, col_values);
+  return dst;
+}
+template <ducks::rt::row_layout T, ducks::rv::align_layout V>
+__device__ static inline void operator/=(T &lhs, const V &col_values) {
+  div_col(lhs, lhs, col_values);
+}
+template <ducks::rt::col_layout T, ducks::rv::ortho_layout V>
+__device__ static inline void operator/=(T &lhs, const V &col_values) {
+  div_col(lhs, lhs, col_values);
+}
+
+/**
+ * @brief Broadcast a vector into into a tile's columns.
+ *
+ * @tparam T Tile type.
+ * @tparam V Row vector type.
+ * @param dst[out] Destination tile where the result is stored.
+ * @param row_values[in] Row vector containing values to broadcast into cols.
+ */
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline void broadcast_col(T &dst, const V &col_values) {
+  col_map<base_ops::copy2, T, V>(dst, dst, col_values);
+}
+template <ducks::rt::all T, ducks::rv::all V>
+__device__ static inline T broadcast_col(const V &col_values) {
+  T dst;
+  broadcast_col(dst, col_values);
+  return dst;
+}
 
 } // namespace kittens
\ No newline at end of file
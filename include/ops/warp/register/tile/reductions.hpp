@@ -0,0 +1,390 @@
+/**
+ * @file
+ * @brief Reduction operations mapping tiles to vectors.
+ */
+
+#pragma once
+
+#include "../../../../common/common.hpp"
+#include "../../../../types/types.hpp"
+
+namespace kittens {
+
+namespace detail {
+
+/**
+ * @brief Reduces the part of each row that a lane holds, without communicating with other lanes.
+ *
+ * For row-layout tiles that is half of each row (one of its 8-column halves of every base tile); for
+ * col-layout tiles it is one element per 32-column accumulator.
+ *
+ * @param partial[out] Per-lane partial reduction, in the layout of the tile's column vectors.
+ * @param src[in] Source tile.
+ */
+template <typename op, ducks::rv::all V, ducks::rt::row_layout T>
+__device__ inline void row_reduce_lane(V &partial, const T &src) {
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::rows);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+  constexpr int P = T::packed_per_tile;
+
+#pragma unroll
+  for (int i = 0; i < src.height; i++) {
+    dtype accum = src.tiles[i][0].data[0];
+#pragma unroll
+    for (int jk = 1; jk < src.width * P; jk++) {
+      accum = op::template op<dtype>(accum, src.tiles[i][jk / P].data[jk % P]);
+    }
+    partial[i][0] = op::template op<typename V::dtype>(accum.x, accum.y);
+  }
+}
+template <typename op, ducks::rv::all V, ducks::rt::col_layout T>
+__device__ inline void row_reduce_lane(V &partial, const T &src) {
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::col_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::rows);                                                                                    // compatible size
+  static_assert(T::width % 2 == 0, "col-layout tiles are made of 32x32 accumulators");
+
+  using dtype = T::dtype;
+  constexpr int P = T::packed_per_tile;
+
+#pragma unroll
+  for (int i = 0; i < src.height; i++) {
+#pragma unroll
+    for (int h = 0; h < 2; h++) {
+#pragma unroll
+      for (int k = 0; k < P; k++) {
+        dtype accum = src.tiles[i][h].data[k];
+#pragma unroll
+        for (int n = 1; n < src.width / 2; n++) {
+          accum = op::template op<dtype>(accum, src.tiles[i][2 * n + h].data[k]);
+        }
+        partial[i][h * P + k] = accum;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Reduces the part of each column that a lane holds, without communicating with other lanes.
+ *
+ * @param partial[out] Per-lane partial reduction, in the layout of the tile's row vectors.
+ * @param src[in] Source tile.
+ */
+template <typename op, ducks::rv::all V, ducks::rt::row_layout T>
+__device__ inline void col_reduce_lane(V &partial, const T &src) {
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::cols);                                                                                    // compatible size
+
+  using dtype = T::dtype;
+
+#pragma unroll
+  for (int j = 0; j < src.width; j++) {
+#pragma unroll
+    for (int k = 0; k < src.packed_per_tile; k++) {
+      dtype accum = src.tiles[0][j].data[k];
+#pragma unroll
+      for (int i = 1; i < src.height; i++) {
+        accum = op::template op<dtype>(accum, src.tiles[i][j].data[k]);
+      }
+      partial[j][k] = accum;
+    }
+  }
+}
+template <typename op, ducks::rv::all V, ducks::rt::col_layout T>
+__device__ inline void col_reduce_lane(V &partial, const T &src) {
+  static_assert(std::is_same_v<typename V::layout, typename rt_base<typename T::T, typename T::layout>::row_vec_layout>); // compatible layout
+  static_assert(std::is_same_v<typename V::T, typename T::T>);                                                            // compatible type
+  static_assert(V::length == T::cols);                                                                                    // compatible size
+  static_assert(T::width % 2 == 0, "col-layout tiles are made of 32x32 accumulators");
+
+  using dtype = T::dtype;
+  constexpr int P = T::packed_per_tile;
+
+#pragma unroll
+  for (int n = 0; n < src.width / 2; n++) {
+    dtype accum = src.tiles[0][2 * n].data[0];
+#pragma unroll
+    for (int ihk = 1; ihk < src.height * 2 * P; ihk++) {
+      accum = op::template op<dtype>(accum, src.tiles[ihk / (2 * P)][2 * n + (ihk / P) % 2].data[ihk % P]);
+    }
+    partial[n][0] = op::template op<typename V::dtype>(accum.x, accum.y);
+  }
+}
+
+/**
+ * @brief Writes a finished reduction into dst, combining it with src_accum unless reset is set.
+ */
+template <typename op, bool reset, ducks::rv::all V>
+__device__ inline void accumulate_reduction(V &dst, const V &partial, const V &src_accum) {
+#pragma unroll
+  for (int o = 0; o < V::outer_dim; o++) {
+#pragma unroll
+    for (int i = 0; i < V::inner_dim; i++) {
+      if constexpr (reset) {
+        dst[o][i] = partial[o][i];
+      } else {
+        dst[o][i] = op::template op<typename V::dtype>(src_accum[o][i], partial[o][i]);
+      }
+    }
+  }
+}
+
+#ifndef KITTENS_EMULATOR
+template <typename op, int step, ducks::rv::all V>
+__device__ inline void butterfly_reduce(V &v) {
+#pragma unroll
+  for (int o = 0; o < V::outer_dim; o++) {
+#pragma unroll
+    for (int i = 0; i < V::inner_dim; i++) {
+      v[o][i] = op::template op<typename V::dtype>(v[o][i], butterfly<step>(v[o][i]));
+    }
+  }
+}
+
+/**
+ * @brief Combines the per-lane partial reductions of every lane holding the same vector elements.
+ *
+ * Lanes l and l ^ 32 hold the two halves of an ortho element, so those take a single exchange. The
+ * 32 lanes sharing an align element each hold a different row or column of it, so those take five
+ * butterfly steps, four of them DPP moves.
+ */
+template <typename op, ducks::rv::all V>
+__device__ inline void reduce_across_lanes(V &v) {
+  if constexpr (std::is_same_v<typename V::layout, ducks::rv_layout::ortho>) {
+    butterfly_reduce<op, 32>(v);
+  } else {
+    butterfly_reduce<op, 1>(v);
+    butterfly_reduce<op, 2>(v);
+    butterfly_reduce<op, 4>(v);
+    butterfly_reduce<op, 8>(v);
+    butterfly_reduce<op, 16>(v);
+  }
+}
+#endif
+
+} // namespace detail
+
+#ifndef KITTENS_EMULATOR // cross-lane; the emulator provides wave-level equivalents.
+/**
+ * @brief Performs row-wise reduction on a matrix using a specified operation.
+ *
+ * Every lane ends up holding the reduction of every row its tile elements belong to.
+ *
+ * @tparam op The operation to be applied for reduction.
+ * @tparam V The vector type for the row accumulator; must be T::col_vec.
+ * @tparam T The matrix type.
+ * @tparam reset A boolean flag indicating whether to ignore src_accum.
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator, used when reset is false.
+ */
+template <typename op, ducks::rv::all V, ducks::rt::all T, bool reset>
+__device__ static inline void row_reduce(V &row_accum, const T &src, const V &src_accum) {
+  V partial;
+  detail::row_reduce_lane<op>(partial, src);
+  detail::reduce_across_lanes<op>(partial);
+  detail::accumulate_reduction<op, reset>(row_accum, partial, src_accum);
+}
+/**
+ * @brief Performs column-wise reduction on a matrix using a specified operation.
+ *
+ * @tparam op The operation to be applied for reduction.
+ * @tparam V The vector type for the column accumulator; must be T::row_vec.
+ * @tparam T The matrix type.
+ * @tparam reset A boolean flag indicating whether to ignore src_accum.
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator, used when reset is false.
+ */
+template <typename op, ducks::rv::all V, ducks::rt::all T, bool reset>
+__device__ static inline void col_reduce(V &col_accum, const T &src, const V &src_accum) {
+  V partial;
+  detail::col_reduce_lane<op>(partial, src);
+  detail::reduce_across_lanes<op>(partial);
+  detail::accumulate_reduction<op, reset>(col_accum, partial, src_accum);
+}
+
+/* ----------  WRAPPERS FOR PRETTINESS  ---------- */
+
+/**
+ * @brief Store the maximum of each row of the src register tile in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_max(V &row_accum, const T &src) {
+  row_reduce<base_ops::max, V, T, true>(row_accum, src, row_accum);
+}
+/**
+ * @brief Store the maximum of each row of the src register tile, combined with src_accum, in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_max(V &row_accum, const T &src, const V &src_accum) {
+  row_reduce<base_ops::max, V, T, false>(row_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the minimum of each row of the src register tile in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_min(V &row_accum, const T &src) {
+  row_reduce<base_ops::min, V, T, true>(row_accum, src, row_accum);
+}
+/**
+ * @brief Store the minimum of each row of the src register tile, combined with src_accum, in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_min(V &row_accum, const T &src, const V &src_accum) {
+  row_reduce<base_ops::min, V, T, false>(row_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the sum of each row of the src register tile in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_sum(V &row_accum, const T &src) {
+  row_reduce<base_ops::sum, V, T, true>(row_accum, src, row_accum);
+}
+/**
+ * @brief Store the sum of each row of the src register tile, combined with src_accum, in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_sum(V &row_accum, const T &src, const V &src_accum) {
+  row_reduce<base_ops::sum, V, T, false>(row_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the product of each row of the src register tile in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_prod(V &row_accum, const T &src) {
+  row_reduce<base_ops::mul, V, T, true>(row_accum, src, row_accum);
+}
+/**
+ * @brief Store the product of each row of the src register tile, combined with src_accum, in the row_accum column vector.
+ *
+ * @param row_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void row_prod(V &row_accum, const T &src, const V &src_accum) {
+  row_reduce<base_ops::mul, V, T, false>(row_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the maximum of each column of the src register tile in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_max(V &col_accum, const T &src) {
+  col_reduce<base_ops::max, V, T, true>(col_accum, src, col_accum);
+}
+/**
+ * @brief Store the maximum of each column of the src register tile, combined with src_accum, in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_max(V &col_accum, const T &src, const V &src_accum) {
+  col_reduce<base_ops::max, V, T, false>(col_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the minimum of each column of the src register tile in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_min(V &col_accum, const T &src) {
+  col_reduce<base_ops::min, V, T, true>(col_accum, src, col_accum);
+}
+/**
+ * @brief Store the minimum of each column of the src register tile, combined with src_accum, in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_min(V &col_accum, const T &src, const V &src_accum) {
+  col_reduce<base_ops::min, V, T, false>(col_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the sum of each column of the src register tile in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_sum(V &col_accum, const T &src) {
+  col_reduce<base_ops::sum, V, T, true>(col_accum, src, col_accum);
+}
+/**
+ * @brief Store the sum of each column of the src register tile, combined with src_accum, in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_sum(V &col_accum, const T &src, const V &src_accum) {
+  col_reduce<base_ops::sum, V, T, false>(col_accum, src, src_accum);
+}
+
+/**
+ * @brief Store the product of each column of the src register tile in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_prod(V &col_accum, const T &src) {
+  col_reduce<base_ops::mul, V, T, true>(col_accum, src, col_accum);
+}
+/**
+ * @brief Store the product of each column of the src register tile, combined with src_accum, in the col_accum row vector.
+ *
+ * @param col_accum[out] The accumulator where the result of the reduction is stored.
+ * @param src[in] The source matrix on which to perform the reduction.
+ * @param src_accum[in] The initial value of the accumulator.
+ */
+template <ducks::rv::all V, ducks::rt::all T>
+__device__ static inline void col_prod(V &col_accum, const T &src, const V &src_accum) {
+  col_reduce<base_ops::mul, V, T, false>(col_accum, src, src_accum);
+}
+#endif
+
+} // namespace kittens
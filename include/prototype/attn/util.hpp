@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @brief Register-fragment helpers for attention kernels that keep scores transposed (keys x queries).
+ *
+ * S^T = K Q^T comes out of mma_ABt as a col-layout accumulator whose lanes each own one query column.
+ * Per-query softmax statistics are then column reductions, which stay almost entirely within a lane,
+ * and the accumulator registers can be fed straight back into the next MFMA as the P operand of
+ * O^T = V^T P^T without a round trip through LDS.
+ */
+
+#pragma once
+
+#include "../../kittens.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace attn {
+
+/**
+ * @brief Reinterprets a transposed score accumulator as the B operand of O^T += V^T P^T.
+ *
+ * MFMA operands only need the same k order on both sides, not the natural one. For k-tile kt this uses
+ * keys 16 * kt + 8 * (j / 4) + 4 * (lane / 32) + j % 4 for register element j, which is exactly what
+ * accumulator element j of lane holds, so the copy is a per-register conversion. The matching A operand
+ * comes from load_operand_transposed().
+ *
+ * @param p[out] Probabilities, queries x keys, in the permuted k order.
+ * @param s[in] Probabilities, keys x queries, as left by mma_ABt and the softmax maps.
+ */
+template <int Q, int KV>
+__device__ inline void accumulator_to_operand(rt_bf<Q, KV> &p, const rt_fl<KV, Q, ducks::rt_layout::col> &s) {
+  using P = rt_bf<Q, KV>;
+#pragma unroll
+  for (int n = 0; n < P::height; n++) {
+#pragma unroll
+    for (int kt = 0; kt < P::width; kt++) {
+#pragma unroll
+      for (int k = 0; k < P::base_tile::packed_per_thread; k++) {
+        p.tiles[n][kt].data[k] = base_types::convertor<bf16_2, float2>::convert(s.tiles[kt / 2][2 * n + kt % 2].data[k]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Loads V^T from a shared V tile as the A operand of O^T += V^T P^T, in the k order of accumulator_to_operand().
+ *
+ * Lanes 0-31 read 32 consecutive columns of one row of src per register element, so the scalar LDS reads
+ * fall in distinct banks.
+ *
+ * @param vt[out] Head dims x keys.
+ * @param src[in] Shared tile holding V, keys x head dims.
+ * @param d_tile[in] First head dim of vt, in units of vt's rows.
+ */
+template <int D, int KV, ducks::st::all ST>
+__device__ inline void load_operand_transposed(rt_bf<D, KV> &vt, const ST &src, int d_tile) {
+  using VT = rt_bf<D, KV>;
+  static_assert(ST::rows == KV, "src must hold exactly the keys of vt");
+  const int lane = kittens::laneid();
+#pragma unroll
+  for (int m = 0; m < VT::height; m++) {
+    const int d = d_tile * D + m * VT::tile_size_row + lane % 32;
+#pragma unroll
+    for (int kt = 0; kt < VT::width; kt++) {
+      bf16 *reg = reinterpret_cast<bf16 *>(vt.tiles[m][kt].data);
+#pragma unroll
+      for (int j = 0; j < 8; j++) {
+        const int kv = kt * VT::tile_size_col + 8 * (j / 4) + 4 * (lane / 32) + j % 4;
+        reg[j] = src[{kv, d}];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Sets to -inf the scores of keys past kv_len and, for causal attention, keys after their query.
+ *
+ * @param s[in,out] Scores, keys x queries.
+ * @param kv_begin[in] Key index of the first row of s.
+ * @param q_begin[in] Query index of the first column of s.
+ * @param kv_len[in] Number of valid keys.
+ * @param causal[in] Also mask key kv for query q when kv > q.
+ */
+template <int KV, int Q>
+__device__ inline void mask_scores(rt_fl<KV, Q, ducks::rt_layout::col> &s, int kv_begin, int q_begin, int kv_len, bool causal) {
+  using S = rt_fl<KV, Q, ducks::rt_layout::col>;
+  const int lane = kittens::laneid();
+#pragma unroll
+  for (int m = 0; m < S::height; m++) {
+#pragma unroll
+    for (int j = 0; j < S::width; j++) {
+      const int q = q_begin + (j / 2) * 32 + lane % 32;
+      float *reg = reinterpret_cast<float *>(s.tiles[m][j].data);
+#pragma unroll
+      for (int e = 0; e < 8; e++) {
+        const int kv = kv_begin + m * S::tile_size_row + 16 * (j % 2) + 8 * (e / 4) + 4 * (lane / 32) + e % 4;
+        if (kv >= kv_len || (causal && kv > q)) reg[e] = base_types::constants<float>::neg_infty();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Stores a transposed output accumulator (head dims x queries) into rows of dst (queries x head dims).
+ *
+ * Each lane owns one query and writes its head dims in runs of four, one 8-byte store per run.
+ * Queries at or past q_len are skipped.
+ *
+ * @param dst[out] Output, with queries along rows and head dims along columns.
+ * @param src[in] Output accumulator, head dims x queries.
+ * @param b[in] Batch index within dst.
+ * @param h[in] Head (depth) index within dst.
+ * @param q_begin[in] Query index of the first column of src.
+ * @param q_len[in] Number of valid queries.
+ * @param d_tile[in] First head dim of src, in units of src's rows.
+ */
+template <int D, int Q, ducks::gl::all GL>
+__device__ inline void store_transposed(GL &dst, const rt_fl<D, Q, ducks::rt_layout::col> &src, int b, int h, int q_begin, int q_len, int d_tile = 0) {
+  using O = rt_fl<D, Q, ducks::rt_layout::col>;
+  using U = typename GL::dtype;
+  static_assert(sizeof(U) == 2, "dst must hold 16-bit elements");
+  const int lane = kittens::laneid();
+#pragma unroll
+  for (int n = 0; n < O::width / 2; n++) {
+    const int q = q_begin + n * 32 + lane % 32;
+    if (q >= q_len) continue;
+    U *row = &dst[{b, h, q, d_tile * D}];
+#pragma unroll
+    for (int m = 0; m < O::height; m++) {
+#pragma unroll
+      for (int half = 0; half < 2; half++) {
+        const float *reg = reinterpret_cast<const float *>(src.tiles[m][2 * n + half].data);
+#pragma unroll
+        for (int run = 0; run < 2; run++) {
+          const int d = m * O::tile_size_row + 16 * half + 8 * run + 4 * (lane / 32);
+          alignas(8) U out[4];
+#pragma unroll
+          for (int i = 0; i < 4; i++) {
+            out[i] = base_types::convertor<U, float>::convert(reg[4 * run + i]);
+          }
+          *reinterpret_cast<int2 *>(&row[d]) = *reinterpret_cast<const int2 *>(out);
+        }
+      }
+    }
+  }
+}
+
+} // namespace attn
+} // namespace prototype
+} // namespace kittens
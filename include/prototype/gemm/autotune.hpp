@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Autotuning of GEMM layout configs, with a persistent shape -> config cache.
+ *
+ * The candidate layouts are template instantiations listed in a config_space, so every config is
+ * compiled ahead of time; at run time dispatch() looks the problem shape up in a tuning_cache and
+ * launches the recorded config, benchmarking all of them with a timer_pool the first time a shape
+ * is seen on a device.
+ */
+
+#pragma once
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#include "../../kittens.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+
+/**
+ * @brief A GEMM problem, as a key of the tuning cache.
+ */
+struct problem_shape {
+  int m, n, k;
+  friend auto operator<=>(const problem_shape &, const problem_shape &) = default;
+};
+
+/**
+ * @brief Name of a layout config in the tuning cache, e.g. "w2x1x4_b2x2x1_s2".
+ *
+ * Built from the wave tile counts, block wave counts and stage count, so it stays valid across rebuilds
+ * as long as the same layout is still compiled in.
+ */
+template <typename layout>
+inline std::string config_name() {
+  std::ostringstream s;
+  s << "w" << layout::wave_tile_count.m << "x" << layout::wave_tile_count.n << "x" << layout::wave_tile_count.k
+    << "_b" << layout::block_wave_count.m << "x" << layout::block_wave_count.n << "x" << layout::block_wave_count.k
+    << "_s" << layout::num_stages;
+  return s.str();
+}
+
+/**
+ * @brief Persistent map from (device, problem shape) to the name of the fastest config.
+ *
+ * Stored as text, one "arch m n k config" line per entry, so a cache can be checked in, diffed and
+ * shared between machines; entries for other architectures are kept but never matched.
+ */
+class tuning_cache {
+public:
+  /**
+   * @brief Opens the cache at path for the current device; a missing file is an empty cache.
+   */
+  inline explicit tuning_cache(std::string path) : path(std::move(path)) {
+    int device;
+    hipDeviceProp_t prop;
+    hipCheck(hipGetDevice(&device));
+    hipCheck(hipGetDeviceProperties(&prop, device));
+    arch = prop.gcnArchName;
+    // Drop feature suffixes such as ":sramecc+:xnack-", which do not affect which config is fastest
+    arch = arch.substr(0, arch.find(':'));
+
+    std::ifstream file(this->path);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream s(line);
+      std::string a, config;
+      problem_shape shape;
+      if (s >> a >> shape.m >> shape.n >> shape.k >> config) entries[{a, shape}] = config;
+    }
+  }
+
+  /**
+   * @brief The config recorded for shape on this device, or nullptr.
+   */
+  inline const std::string *find(const problem_shape &shape) const {
+    auto it = entries.find({arch, shape});
+    return it == entries.end() ? nullptr : &it->second;
+  }
+
+  /**
+   * @brief Records config for shape on this device and rewrites the file.
+   */
+  inline void insert(const problem_shape &shape, const std::string &config) {
+    entries[{arch, shape}] = config;
+    std::ofstream file(path);
+    file << "# arch m n k config" << std::endl;
+    for (const auto &[key, c] : entries) {
+      const auto &[a, s] = key;
+      file << a << " " << s.m << " " << s.n << " " << s.k << " " << c << std::endl;
+    }
+    if (!file) std::cerr << "Could not write tuning cache " << path << std::endl;
+  }
+
+private:
+  std::string path;
+  std::string arch;
+  std::map<std::tuple<std::string, problem_shape>, std::string> entries;
+};
+
+/**
+ * @brief A compile-time list of layout configs to choose between.
+ *
+ * Launchers are generic lambdas called as launch.template operator()<layout>(); they must be safe to
+ * run repeatedly on the same buffers, since tuning runs every config on the caller's problem.
+ */
+template <typename... layouts>
+struct config_space {
+  static_assert(sizeof...(layouts) > 0, "a config space needs at least one layout");
+
+  /**
+   * @brief Calls launch with the layout named config; returns false if no layout has that name.
+   */
+  template <typename F>
+  static bool visit(const std::string &config, F &&launch) {
+    return ((config == config_name<layouts>() && (launch.template operator()<layouts>(), true)) || ...);
+  }
+
+  /**
+   * @brief Times every layout on the current problem and returns the name of the fastest.
+   *
+   * @param launch[in] Launcher, as for visit().
+   * @param warmup[in] Untimed launches per layout.
+   * @param iters[in] Timed launches per layout; the mean is compared.
+   */
+  template <typename F>
+  static std::string tune(F &&launch, int warmup = 2, int iters = 10) {
+    std::string best;
+    float best_ms = std::numeric_limits<float>::infinity();
+    auto time = [&]<typename layout>() {
+      for (int i = 0; i < warmup; i++) launch.template operator()<layout>();
+      timer_pool timers(nullptr, 2 * iters);
+      for (int i = 0; i < iters; i++) {
+        auto region = timers.time("launch");
+        launch.template operator()<layout>();
+      }
+      timers.resolve();
+      const float ms = timers.stats().at("launch").mean_ms();
+      std::cout << "  " << config_name<layout>() << ": " << ms << " ms" << std::endl;
+      if (ms < best_ms) {
+        best_ms = ms;
+        best = config_name<layout>();
+      }
+    };
+    (time.template operator()<layouts>(), ...);
+    return best;
+  }
+
+  /**
+   * @brief Launches the cached config for shape, tuning and recording one first if there is none.
+   *
+   * A cache entry naming a layout that is no longer compiled in is re-tuned.
+   *
+   * @return The name of the config that was launched.
+   */
+  template <typename F>
+  static std::string dispatch(tuning_cache &cache, const problem_shape &shape, F &&launch) {
+    if (const std::string *config = cache.find(shape); config && visit(*config, launch)) return *config;
+    std::cout << "Tuning (" << shape.m << ", " << shape.n << ", " << shape.k << ")" << std::endl;
+    std::string best = tune(launch);
+    cache.insert(shape, best);
+    visit(best, launch);
+    return best;
+  }
+};
+
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Composable GEMM epilogues, applied to the fp32 accumulator between the main loop and the store.
+ *
+ * An epilogue is a list of ops, each a struct with
+ *
+ *     template <ducks::rt::col_layout RT, typename G>
+ *     __device__ static void apply(RT &c, const G &g, int wave_m, int wave_n);
+ *
+ * where g is the kernel's globals and (wave_m, wave_n) is the wave's output tile in units of c. Ops that
+ * read extra tensors name them as pointers to members of the globals, so one kernel serves any epilogue:
+ *
+ *     using ep = epilogue::chain<epilogue::bias<&globals::bias>, epilogue::map<base_ops::relu>,
+ *                                epilogue::residual<&globals::R>>;
+ *
+ * Everything runs on the accumulator registers, and the downcast to the output type happens once, in
+ * the final store, instead of in separate elementwise kernels that each re-read C from HBM.
+ */
+
+#pragma once
+
+#include "../../kittens.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+namespace epilogue {
+
+/**
+ * @brief Applies a unary base_ops functor, e.g. base_ops::relu or base_ops::exp, to every element.
+ */
+template <typename op>
+struct map {
+  template <ducks::rt::col_layout RT, typename G>
+  __device__ static inline void apply(RT &c, const G &, int, int) {
+    unary_map<op>(c, c);
+  }
+};
+
+/**
+ * @brief Multiplies every element by a scalar member of the globals, e.g. an fp8 descale or alpha.
+ */
+template <auto member>
+struct scale {
+  template <ducks::rt::col_layout RT, typename G>
+  __device__ static inline void apply(RT &c, const G &g, int, int) {
+    mul(c, c, g.*member);
+  }
+};
+
+/**
+ * @brief Adds a bias along N, read from a global whose columns hold one value per output column.
+ */
+template <auto member>
+struct bias {
+  template <ducks::rt::col_layout RT, typename G>
+  __device__ static inline void apply(RT &c, const G &g, int, int wave_n) {
+    typename RT::row_vec b;
+    load_bounded(b, g.*member, {wave_n});
+    add_col(c, c, b);
+  }
+};
+
+/**
+ * @brief Adds a residual with the shape of C, e.g. the skip connection of a transformer block.
+ *
+ * The residual may alias C: each lane reads exactly the elements it later stores.
+ */
+template <auto member>
+struct residual {
+  template <ducks::rt::col_layout RT, typename G>
+  __device__ static inline void apply(RT &c, const G &g, int wave_m, int wave_n) {
+    RT r;
+    load_bounded(r, g.*member, {wave_m, wave_n});
+    add(c, c, r);
+  }
+};
+
+/**
+ * @brief Runs ops in order; chain<> is the identity epilogue.
+ */
+template <typename... ops>
+struct chain {
+  template <ducks::rt::col_layout RT, typename G>
+  __device__ static inline void apply(RT &c, const G &g, int wave_m, int wave_n) {
+    (ops::apply(c, g, wave_m, wave_n), ...);
+  }
+};
+using none = chain<>;
+
+} // namespace epilogue
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @brief Software-pipelined GEMM main loop, built from the group-level tile ops.
+ */
+
+#pragma once
+
+#include "../../kittens.hpp"
+#include "util.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+
+/**
+ * @brief Multi-stage main loop accumulating C += A * B^T for one block of a GEMM.
+ *
+ * Global reads run STAGES - 1 k-tiles ahead of the MFMAs. The reads for k-tile (k + STAGES - 1) are issued
+ * into registers before the MFMAs of k-tile k, and each register buffer is written to LDS only at the end
+ * of the iteration before its k-tile is used, so a read's latency is hidden behind STAGES - 1 iterations
+ * of math. The reads in flight live in a ring of STAGES - 1 prefetch buffers; LDS itself only ever needs
+ * the k-tile being multiplied and the next one, so it is double buffered whatever STAGES is, and a single
+ * __syncthreads() per k-tile is enough.
+ *
+ * @tparam layout Block/wave decomposition, with the members of the coord_mnk based kernel layouts
+ *         (block_size, wave_size, block_wave_count, num_waves).
+ * @tparam STAGES Pipeline depth: the k-tile being multiplied plus the STAGES - 1 being read. Each stage
+ *         past the second costs one block tile of A and B in registers per group, not LDS.
+ * @tparam bounded Zero-fill the parts of A and B tiles that fall outside their runtime dimensions, so
+ *         M, N and K need not be multiples of the block size.
+ * @tparam T Element type of A and B, bf16 or one of the fp8 formats; fp8 needs layout::block_size.k and
+ *         layout::wave_size.k to be multiples of 32.
+ */
+template <typename layout, int STAGES, bool bounded = false, typename T = bf16>
+struct mainloop_ABt {
+  static_assert(STAGES >= 2, "a pipelined main loop needs at least two stages");
+  static constexpr int stages = STAGES;
+  static constexpr int prefetch_depth = STAGES - 1; ///< k-tiles whose global reads are in flight.
+
+  using G = group<layout::num_waves>;
+  using a_tile = st<T, layout::block_size.m, layout::block_size.k>;
+  using b_tile = st<T, layout::block_size.n, layout::block_size.k>;
+  using a_reg_t = rt<T, layout::wave_size.m, layout::wave_size.k>;
+  using b_reg_t = rt<T, layout::wave_size.n, layout::wave_size.k>;
+  using c_reg_t = rt_fl<layout::wave_size.m, layout::wave_size.n, ducks::rt_layout::col>;
+
+  /**
+   * @brief Shared memory used by the main loop; allocate it with shared_allocator.
+   */
+  struct smem {
+    a_tile a[2];
+    b_tile b[2];
+  };
+
+#ifndef KITTENS_EMULATOR
+  /**
+   * @brief Accumulates k-tiles [k_begin, k_end) of A and B into c_reg.
+   *
+   * Must be called by every wave of the block. c_reg is not zeroed, so partial sums can be continued.
+   *
+   * @param c_reg[in,out] This wave's accumulator.
+   * @param s[in] Shared double buffer; its contents on entry are overwritten.
+   * @param A[in] Global layout of A, M x K.
+   * @param B[in] Global layout of B, N x K.
+   * @param block_m[in] Row of this block's C tile, in units of layout::block_size.m.
+   * @param block_n[in] Column of this block's C tile, in units of layout::block_size.n.
+   * @param k_begin[in] First k-tile, in units of layout::block_size.k.
+   * @param k_end[in] One past the last k-tile.
+   * @param batch[in] Batch index of the problem, for batched GEMMs. A or B is broadcast if its batch extent is 1.
+   * @param depth[in] Depth index of the problem, broadcast the same way.
+   */
+  template <ducks::gl::all GL_A, ducks::gl::all GL_B>
+  __device__ static inline void run(c_reg_t &c_reg, smem &s, const GL_A &A, const GL_B &B, int block_m, int block_n, int k_begin, int k_end, int batch = 0, int depth = 0) {
+    const int wave_m = waveid() / layout::block_wave_count.n;
+    const int wave_n = waveid() % layout::block_wave_count.n;
+    const int num_k_tiles = k_end - k_begin;
+    const int a_b = broadcast_index(A.batch(), batch), a_d = broadcast_index(A.depth(), depth);
+    const int b_b = broadcast_index(B.batch(), batch), b_d = broadcast_index(B.depth(), depth);
+
+    auto load_tile = [&](int k) {
+      if constexpr (bounded) {
+        G::load_bounded(s.a[k % 2], A, {a_b, a_d, block_m, k_begin + k});
+        G::load_bounded(s.b[k % 2], B, {b_b, b_d, block_n, k_begin + k});
+      } else {
+        G::load(s.a[k % 2], A, {a_b, a_d, block_m, k_begin + k});
+        G::load(s.b[k % 2], B, {b_b, b_d, block_n, k_begin + k});
+      }
+    };
+    // k-tile k is read into buffer k % prefetch_depth; the loop below steps in whole rings so that index is static
+    typename G::template prefetch_buffer<a_tile> a_next[prefetch_depth];
+    typename G::template prefetch_buffer<b_tile> b_next[prefetch_depth];
+    auto prefetch_tile = [&](auto &a_buf, auto &b_buf, int k) {
+      if constexpr (bounded) {
+        G::prefetch_bounded(a_buf, A, {a_b, a_d, block_m, k_begin + k});
+        G::prefetch_bounded(b_buf, B, {b_b, b_d, block_n, k_begin + k});
+      } else {
+        G::prefetch(a_buf, A, {a_b, a_d, block_m, k_begin + k});
+        G::prefetch(b_buf, B, {b_b, b_d, block_n, k_begin + k});
+      }
+    };
+
+    // The first k-tile goes straight to LDS; the reads of the next STAGES - 2 are left in flight
+    if (num_k_tiles > 0) load_tile(0);
+#pragma unroll
+    for (int k = 1; k < prefetch_depth; k++) {
+      if (k < num_k_tiles) prefetch_tile(a_next[k], b_next[k], k);
+    }
+
+    a_reg_t a_reg;
+    b_reg_t b_reg;
+    for (int ring = 0; ring < num_k_tiles; ring += prefetch_depth) {
+#pragma unroll
+      for (int j = 0; j < prefetch_depth; j++) {
+        const int k = ring + j;
+        if (k >= num_k_tiles) break;
+        // Makes k-tile k visible, and retires every read of the buffer the commit below will overwrite
+        __syncthreads();
+
+        // Buffer j held k-tile k, committed at the end of the last iteration
+        const int next = k + prefetch_depth;
+        if (next < num_k_tiles) prefetch_tile(a_next[j], b_next[j], next);
+
+        load(a_reg, s.a[k % 2], {wave_m, 0});
+        load(b_reg, s.b[k % 2], {wave_n, 0});
+        mma_ABt(c_reg, a_reg, b_reg);
+
+        if (k + 1 < num_k_tiles) {
+          G::commit(s.a[(k + 1) % 2], a_next[(j + 1) % prefetch_depth]);
+          G::commit(s.b[(k + 1) % 2], b_next[(j + 1) % prefetch_depth]);
+        }
+      }
+    }
+    // Leave LDS free for the caller to reuse
+    __syncthreads();
+  }
+#endif
+};
+
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
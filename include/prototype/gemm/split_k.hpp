@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @brief Split-K work distribution for GEMMs, reducing the partial accumulators with atomics or a tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../../kittens.hpp"
+#include "util.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+
+/**
+ * @brief How split_k combines the partial sums of the blocks sharing an output tile.
+ */
+enum class split_k_reduction {
+  atomic, ///< fp32 atomic adds into one workspace tile. Fewest passes, but the sum order varies run to run.
+  tree,   ///< Fixed binary tree through the workspace. Bitwise reproducible for a given split count.
+};
+
+/**
+ * @brief Split-K scheduler: each output tile is computed by `splits` blocks, each over its own range of K.
+ *
+ * Launch a grid of num_tiles() x splits blocks. After its main loop each block calls reduce(); the one
+ * block per tile that comes out holding the full sum stores it. No block ever waits on another, so any
+ * grid size is safe.
+ *
+ * With split_k_reduction::tree, the blocks of a tile are the leaves of a binary tree over the split index.
+ * At each node the first of the two subtrees to arrive leaves its sum in the workspace and retires; the
+ * second adds it and carries on up. Every node therefore adds the same two values whatever the arrival
+ * order, and since fp32 addition is commutative the result is the same on every run.
+ *
+ * @tparam layout Block/wave decomposition, with the members of the coord_mnk based kernel layouts.
+ */
+template <typename layout>
+struct split_k {
+  int tiles_m, tiles_n;              ///< Output tiles along M and N.
+  int k_tiles;                       ///< k-tiles per output tile.
+  int splits;                        ///< Blocks per output tile.
+  split_k_reduction reduction;       ///< How the partial sums are combined.
+  raster_order raster;               ///< Order in which blockIdx.x walks the output tiles.
+
+  int *counters;                     ///< Per tile: arrivals (atomic), or arrivals per tree node (tree).
+  float *partials;                   ///< Per tile: one block tile (atomic), or one per split (tree).
+
+  /* ----------  HOST  ---------- */
+
+  /**
+   * @brief Plans an M x N x K problem with K split `splits` ways; clamped so each split has a k-tile.
+   *
+   * Call attach() before launching.
+   */
+  __host__ static split_k plan(int M, int N, int K, int splits, split_k_reduction reduction, raster_order raster = raster_order::grouped_m) {
+    split_k s{};
+    s.tiles_m = (M + layout::block_size.m - 1) / layout::block_size.m;
+    s.tiles_n = (N + layout::block_size.n - 1) / layout::block_size.n;
+    s.k_tiles = (K + layout::block_size.k - 1) / layout::block_size.k;
+    s.splits = std::max(1, std::min(splits, s.k_tiles));
+    s.reduction = reduction;
+    s.raster = raster;
+    return s;
+  }
+
+  __host__ __device__ inline int num_tiles() const { return tiles_m * tiles_n; }
+
+  /**
+   * @brief Grid to launch: blockIdx.x walks the tiles, blockIdx.y the splits.
+   */
+  __host__ dim3 grid() const { return dim3(num_tiles(), splits); }
+
+  /**
+   * @brief Size of the device workspace attach() expects.
+   */
+  __host__ size_t workspace_bytes() const {
+    const size_t slots = reduction == split_k_reduction::atomic ? num_tiles() : size_t(num_tiles()) * splits;
+    return 16 + size_t(num_tiles()) * splits * sizeof(int) + slots * layout::block_size.m * layout::block_size.n * sizeof(float);
+  }
+
+  /**
+   * @brief Points the scheduler at its device workspace.
+   *
+   * The workspace must be zeroed before the first launch; the kernel leaves it zeroed again when it
+   * finishes, so the same workspace can be reused by later launches on the same stream.
+   */
+  __host__ void attach(void *workspace) {
+    counters = reinterpret_cast<int *>(workspace);
+    // partials are accessed as float4
+    uintptr_t p = reinterpret_cast<uintptr_t>(counters + size_t(num_tiles()) * splits);
+    partials = reinterpret_cast<float *>((p + 15) & ~uintptr_t(15));
+  }
+
+  /* ----------  DECOMPOSITION  ---------- */
+
+  /**
+   * @brief The work of one block.
+   *
+   * @param tile[in] Output tile, in processing order (blockIdx.x).
+   * @param split[in] Split index (blockIdx.y); reported as the segment's unit.
+   */
+  __host__ __device__ inline work_segment segment(int tile, int split) const {
+    const coord_mnk mn = rasterize(tile, tiles_m, tiles_n, raster);
+    const int k_begin = int64_t(k_tiles) * split / splits;
+    const int k_end = int64_t(k_tiles) * (split + 1) / splits;
+    return work_segment{tile, mn.m, mn.n, k_begin, k_end, split, k_begin == 0, k_end == k_tiles};
+  }
+
+  /* ----------  DEVICE  ---------- */
+
+#ifndef KITTENS_EMULATOR
+  /**
+   * @brief Combines this block's partial sums with those of the other splits of its tile.
+   *
+   * Must be called by every thread of the block.
+   *
+   * @return Whether this block now holds the full sum in c_reg and should store it. Exactly one block
+   *         per tile returns true.
+   */
+  template <ducks::rt::col_layout RT>
+  __device__ inline bool reduce(RT &c_reg, const work_segment &seg) const {
+    if (splits == 1) return true;
+    if (reduction == split_k_reduction::atomic) return reduce_atomic(c_reg, seg);
+    return reduce_tree(c_reg, seg);
+  }
+
+  template <ducks::rt::col_layout RT>
+  __device__ inline bool reduce_atomic(RT &c_reg, const work_segment &seg) const {
+    auto slice = detail::partial_slice<layout, RT>(partials, seg.tile);
+    auto acc = reinterpret_cast<float4 *>(&c_reg);
+#pragma unroll
+    for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+      float *dst = reinterpret_cast<float *>(&slice[i * WAVE_THREADS]);
+      unsafeAtomicAdd(&dst[0], acc[i].x);
+      unsafeAtomicAdd(&dst[1], acc[i].y);
+      unsafeAtomicAdd(&dst[2], acc[i].z);
+      unsafeAtomicAdd(&dst[3], acc[i].w);
+    }
+    if (arrive(counters[seg.tile]) != splits - 1) return false;
+
+    // Last to arrive: every split's adds have landed. Take the sum and leave the slot zeroed.
+    if (group<layout::num_waves>::laneid() == 0) counters[seg.tile] = 0;
+#pragma unroll
+    for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+      acc[i] = slice[i * WAVE_THREADS];
+      slice[i * WAVE_THREADS] = float4{0.f, 0.f, 0.f, 0.f};
+    }
+    return true;
+  }
+
+  template <ducks::rt::col_layout RT>
+  __device__ inline bool reduce_tree(RT &c_reg, const work_segment &seg) const {
+    auto acc = reinterpret_cast<float4 *>(&c_reg);
+    const size_t tile_slots = size_t(seg.tile) * splits;
+    int node = seg.unit;
+    for (int level = 0; (1 << level) < splits; level++) {
+      const int sibling = node ^ 1;
+      if ((sibling << level) < splits) {
+        // Subtrees are stored under their first leaf; internal nodes are counted at their in-order index
+        auto mine = detail::partial_slice<layout, RT>(partials, tile_slots + (node << level));
+#pragma unroll
+        for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+          mine[i * WAVE_THREADS] = acc[i];
+        }
+        int &counter = counters[tile_slots + ((node >> 1) << (level + 1)) + (1 << level) - 1];
+        if (arrive(counter) == 0) return false;
+        if (group<layout::num_waves>::laneid() == 0) counter = 0;
+
+        auto theirs = detail::partial_slice<layout, RT>(partials, tile_slots + (sibling << level));
+#pragma unroll
+        for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+          const float4 p = theirs[i * WAVE_THREADS];
+          acc[i].x += p.x;
+          acc[i].y += p.y;
+          acc[i].z += p.z;
+          acc[i].w += p.w;
+        }
+      }
+      node >>= 1;
+    }
+    return true;
+  }
+
+private:
+  /**
+   * @brief Makes this block's prior writes visible device-wide, then bumps counter once for the block.
+   *
+   * @return The counter's value before the increment, the same in every thread.
+   */
+  __device__ inline int arrive(int &counter) const {
+    __shared__ int arrived;
+    __threadfence();
+    __syncthreads();
+    if (group<layout::num_waves>::laneid() == 0) arrived = atomicAdd(&counter, 1);
+    __syncthreads();
+    const int result = arrived;
+    // Acquire: later reads of the workspace must not hit stale cache lines
+    __threadfence();
+    __syncthreads();
+    return result;
+  }
+#endif
+};
+
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @brief Persistent stream-K work distribution for GEMMs, with a fix-up pass for split output tiles.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../../kittens.hpp"
+#include "util.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+
+/**
+ * @brief Stream-K scheduler for a persistent GEMM launched with one block per CU.
+ *
+ * The output tiles are split in two. The "stream-K" tiles, at most two per block, have their k-tiles laid
+ * end to end and cut into one equal range per block, so every block does the same number of MFMAs no
+ * matter how the tile count divides the CU count. The remaining tiles are handed out whole. Blocks pull
+ * work units (a stream-K range or a whole tile) from a global atomic counter until none are left.
+ *
+ * A stream-K range usually starts and ends in the middle of a tile. The block whose range covers the
+ * last k-tile of an output tile owns it: it adds the fp32 partial sums published by the earlier units
+ * that covered the rest of the tile, then stores the result. Each unit publishes at most one partial
+ * (its last segment), and does so before anything else, so an owner only ever waits on units that have
+ * already been claimed and are running.
+ *
+ * @tparam layout Block/wave decomposition, with the members of the coord_mnk based kernel layouts.
+ */
+template <typename layout>
+struct stream_k {
+  int tiles_m, tiles_n;  ///< Output tiles along M and N.
+  int k_tiles;           ///< k-tiles per output tile.
+  int sk_tiles;          ///< Output tiles, from the first, that are split across stream-K units.
+  int sk_units;          ///< Stream-K units, one per block; units [0, sk_units) are stream-K.
+  int num_units;         ///< sk_units plus one unit per remaining whole tile.
+  raster_order raster;   ///< Order in which tiles are handed out.
+
+  int *counters;         ///< [0]: next unit to hand out, [1]: blocks that ran out of work.
+  int *flags;            ///< Per stream-K unit: set once its partial is published.
+  float *partials;       ///< Per stream-K unit: one block tile of fp32 partial sums.
+
+  /* ----------  HOST  ---------- */
+
+  /**
+   * @brief Plans the work for an M x N x K problem on num_blocks persistent blocks.
+   *
+   * Call attach() before launching.
+   */
+  __host__ static stream_k plan(int M, int N, int K, int num_blocks, raster_order raster = raster_order::grouped_m) {
+    stream_k s{};
+    s.raster = raster;
+    s.tiles_m = (M + layout::block_size.m - 1) / layout::block_size.m;
+    s.tiles_n = (N + layout::block_size.n - 1) / layout::block_size.n;
+    s.k_tiles = (K + layout::block_size.k - 1) / layout::block_size.k;
+
+    const int num_tiles = s.tiles_m * s.tiles_n;
+    // Only the tiles that would otherwise form a partial last wave are split, plus one more full wave
+    // when there is one to spare, so no unit has less than one tile's worth of k-tiles
+    s.sk_tiles = num_tiles % num_blocks;
+    if (s.sk_tiles != 0 && num_tiles >= 2 * num_blocks) s.sk_tiles += num_blocks;
+    s.sk_units = s.sk_tiles == 0 ? 0 : std::min(num_blocks, s.sk_tiles * s.k_tiles);
+    s.num_units = s.sk_units + (num_tiles - s.sk_tiles);
+    return s;
+  }
+
+  /**
+   * @brief Size of the device workspace attach() expects.
+   */
+  __host__ size_t workspace_bytes() const {
+    return 2 * sizeof(int) + sk_units * sizeof(int) + size_t(sk_units) * layout::block_size.m * layout::block_size.n * sizeof(float);
+  }
+
+  /**
+   * @brief Points the scheduler at its device workspace.
+   *
+   * The workspace must be zeroed before the first launch; the kernel leaves it zeroed again when it
+   * finishes, so the same workspace can be reused by later launches on the same stream.
+   */
+  __host__ void attach(void *workspace) {
+    counters = reinterpret_cast<int *>(workspace);
+    flags = counters + 2;
+    // partials are accessed as float4
+    uintptr_t p = reinterpret_cast<uintptr_t>(flags + sk_units);
+    partials = reinterpret_cast<float *>((p + 15) & ~uintptr_t(15));
+  }
+
+  /* ----------  DECOMPOSITION  ---------- */
+
+  __host__ __device__ inline int64_t sk_iters() const { return int64_t(sk_tiles) * k_tiles; }
+  /**
+   * @brief First k-tile, counted across all stream-K tiles, of stream-K unit u.
+   */
+  __host__ __device__ inline int64_t sk_unit_begin(int u) const { return sk_iters() * u / sk_units; }
+
+  /**
+   * @brief Calls fn(work_segment) for every segment of a unit, last k-tiles first.
+   */
+  template <typename F>
+  __host__ __device__ inline void for_each_segment(int unit, F &&fn) const {
+    if (unit >= sk_units) {
+      const int tile = sk_tiles + (unit - sk_units);
+      const coord_mnk mn = rasterize(tile, tiles_m, tiles_n, raster);
+      fn(work_segment{tile, mn.m, mn.n, 0, k_tiles, unit, true, true});
+      return;
+    }
+    const int64_t begin = sk_unit_begin(unit);
+    int64_t end = sk_unit_begin(unit + 1);
+    while (end > begin) {
+      const int tile = (end - 1) / k_tiles;
+      const int64_t tile_begin = int64_t(tile) * k_tiles;
+      const int64_t seg_begin = begin > tile_begin ? begin : tile_begin;
+      const int k_begin = seg_begin - tile_begin, k_end = end - tile_begin;
+      const coord_mnk mn = rasterize(tile, tiles_m, tiles_n, raster);
+      fn(work_segment{tile, mn.m, mn.n, k_begin, k_end, unit, k_begin == 0, k_end == k_tiles});
+      end = seg_begin;
+    }
+  }
+
+  /* ----------  DEVICE  ---------- */
+
+#ifndef KITTENS_EMULATOR
+  /**
+   * @brief Runs fn(work_segment) for every segment this block claims, until the work runs out.
+   *
+   * Must be called by every thread of the block, with the same arguments.
+   */
+  template <typename F>
+  __device__ inline void run(F &&fn) const {
+    using G = group<layout::num_waves>;
+    __shared__ int unit;
+    while (true) {
+      __syncthreads();
+      if (G::laneid() == 0) unit = atomicAdd(&counters[0], 1);
+      __syncthreads();
+      if (unit >= num_units) break;
+      for_each_segment(unit, fn);
+    }
+    // The last block out resets the counters for the next launch
+    if (G::laneid() == 0 && atomicAdd(&counters[1], 1) == int(gridDim.x) - 1) {
+      atomicExch(&counters[0], 0);
+      atomicExch(&counters[1], 0);
+    }
+  }
+
+  /**
+   * @brief Publishes the partial sums of a segment that does not end its tile.
+   */
+  template <ducks::rt::col_layout RT>
+  __device__ inline void publish(const RT &c_reg, const work_segment &seg) const {
+    using G = group<layout::num_waves>;
+    auto dst = detail::partial_slice<layout, RT>(partials, seg.unit);
+    auto src = reinterpret_cast<const float4 *>(&c_reg);
+#pragma unroll
+    for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+      dst[i * WAVE_THREADS] = src[i];
+    }
+    __threadfence();
+    __syncthreads();
+    if (G::laneid() == 0) atomicExch(&flags[seg.unit], 1);
+  }
+
+  /**
+   * @brief Adds into c_reg the partial sums of every earlier unit that covered part of seg's tile.
+   *
+   * For segments that end their tile but do not start it.
+   */
+  template <ducks::rt::col_layout RT>
+  __device__ inline void accumulate(RT &c_reg, const work_segment &seg) const {
+    using G = group<layout::num_waves>;
+    const int64_t tile_begin = int64_t(seg.tile) * k_tiles;
+    auto acc = reinterpret_cast<float4 *>(&c_reg);
+    for (int u = seg.unit - 1; u >= 0; u--) {
+      if (G::laneid() == 0) {
+        while (atomicAdd(&flags[u], 0) == 0) {
+          __builtin_amdgcn_s_sleep(1);
+        }
+        flags[u] = 0;
+      }
+      __syncthreads();
+      __threadfence();
+      auto src = detail::partial_slice<layout, RT>(partials, u);
+#pragma unroll
+      for (int i = 0; i < detail::partial_slice_size<RT>; i++) {
+        const float4 p = src[i * WAVE_THREADS];
+        acc[i].x += p.x;
+        acc[i].y += p.y;
+        acc[i].z += p.z;
+        acc[i].w += p.w;
+      }
+      if (sk_unit_begin(u) <= tile_begin) break;
+    }
+  }
+#endif
+};
+
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
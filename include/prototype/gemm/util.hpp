@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Pieces shared by the GEMM schedulers.
+ */
+
+#pragma once
+
+#include "../../kittens.hpp"
+
+namespace kittens {
+namespace prototype {
+namespace gemm {
+
+/**
+ * @brief A contiguous run of k-tiles of one output tile, processed by one block in one go.
+ */
+struct work_segment {
+  int tile;            ///< Output tile, as its index in processing order.
+  int tile_m, tile_n;  ///< Output tile, in units of the block size.
+  int k_begin, k_end;  ///< Range of k-tiles, in units of the block k size.
+  int unit;            ///< Work unit the segment belongs to.
+  bool starts_tile;    ///< Whether k_begin is the first k-tile of the output tile.
+  bool ends_tile;      ///< Whether k_end is one past the last k-tile of the output tile.
+};
+
+/**
+ * @brief Index to read an operand at along a batch axis: 0 when the operand is broadcast (extent 1).
+ */
+__host__ __device__ inline int broadcast_index(int extent, int idx) { return extent == 1 ? 0 : idx; }
+
+#ifndef KITTENS_EMULATOR
+namespace detail {
+/**
+ * @brief This lane's slice of one block tile of fp32 partial sums in a global workspace.
+ *
+ * Partials are kept in the accumulator's register layout, interleaved across lanes, so a block tile is
+ * written and read back with fully coalesced 16-byte accesses and no shuffles.
+ *
+ * @param partials[in] Start of the workspace.
+ * @param slot[in] Index of the block tile within the workspace.
+ */
+template <typename layout, ducks::rt::col_layout RT>
+__device__ inline float4 *partial_slice(float *partials, size_t slot) {
+  static_assert(std::is_same_v<typename RT::T, float>, "partial sums are kept in fp32");
+  static_assert(sizeof(RT) * layout::num_waves * WAVE_THREADS == layout::block_size.m * layout::block_size.n * sizeof(float),
+                "each wave must hold its share of the block tile");
+  constexpr int per_wave = sizeof(RT) / sizeof(float4) * WAVE_THREADS;
+  return reinterpret_cast<float4 *>(partials) + (slot * layout::num_waves + waveid()) * per_wave + kittens::laneid();
+}
+
+/**
+ * @brief Number of float4 slice entries per lane; entry i of a lane lives at slice[i * WAVE_THREADS].
+ */
+template <ducks::rt::col_layout RT>
+constexpr int partial_slice_size = sizeof(RT) / sizeof(float4);
+} // namespace detail
+#endif
+
+} // namespace gemm
+} // namespace prototype
+} // namespace kittens
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../kittens.hpp"
+#include "gemm/mainloop.hpp"
+#include "gemm/epilogue.hpp"
+#include "gemm/autotune.hpp"
+#include "gemm/stream_k.hpp"
+#include "gemm/split_k.hpp"
+#include "attn/util.hpp"
@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <cstddef>
 #include "../register/register.hpp"
+#include "../shared/shared.hpp"
 
 namespace kittens {
 namespace ducks {
@@ -33,9 +34,10 @@ using make_arg_t = std::conditional_t<rdim<d>, size_t, std::nullptr_t>; // we pa
 
 namespace detail {
 template <typename T>
-concept tile = ducks::rt::all<T> || ducks::rt_base::all<T>;
+concept tile = ducks::st::all<T> || ducks::rt::all<T> || ducks::rt_base::all<T>;
 // concept tile = ducks::st::all<T> || ducks::rt::all<T> || ducks::cst::all<T> || ducks::crt::all<T>;
-// TODO: template<typename T> concept vec  = ducks::sv::all<T> || ducks::rv::all<T> || ducks::csv::all<T> || ducks::crv::all<T>;
+template <typename T>
+concept vec = ducks::rv::all<T>;
 } // namespace detail
 
 namespace ducks {
@@ -47,7 +49,7 @@ template <typename _T = ducks::default_type>
 struct coord { // essentially a named int4 for tensor coordinates.
   using identifier = ducks::coord::identifier;
   using BASE = _T; // in units of what type?
-  // static_assert(std::is_same_v<BASE, ducks::default_type> || detail::tile<BASE> /*|| detail::vec<BASE>*/); // ensure BASE is a valid type
+  // static_assert(std::is_same_v<BASE, ducks::default_type> || detail::tile<BASE> || detail::vec<BASE>); // ensure BASE is a valid type
   int b, d, r, c;
   __device__ inline coord(int _b, int _d, int _r, int _c) : b(_b), d(_d), r(_r), c(_c) {}
   __device__ inline coord(int _d, int _r, int _c) : b(0), d(_d), r(_r), c(_c) {}
@@ -70,13 +72,12 @@ struct coord { // essentially a named int4 for tensor coordinates.
           row_axis == 1 ? d * BASE::rows : d,
           row_axis == 2 ? r * BASE::rows : r,
           c * BASE::cols);
-    } /*else if constexpr (detail::vec<BASE>) {
+    } else if constexpr (detail::vec<BASE>) {
       static_assert(row_axis == -1, "row axis must be be -1 for a vector coordinate to be converted to a unit coordinate");
       static_assert(col_axis >= 0 && col_axis <= 3, "column axis must be between 0 and 3");
       static_assert(col_axis == 3, "for now, column axis must be 3");
       return coord<ducks::default_type>(b, d, r, c * BASE::length);
-    }*/
-    else {
+    } else {
       return coord<ducks::default_type>(*this);
     }
   }
@@ -109,8 +110,8 @@ concept all = requires {
 } && std::is_same_v<typename T::identifier, identifier>; // Checks if T::identifier is ducks::coord::identifier
 template <typename T>
 concept tile = all<T> && (std::is_same_v<typename T::BASE, ducks::default_type> || detail::tile<typename T::BASE>);
-// template <typename T>
-// concept vec = all<T> && (std::is_same_v<typename T::BASE, ducks::default_type> || detail::vec<typename T::BASE>);
+template <typename T>
+concept vec = all<T> && (std::is_same_v<typename T::BASE, ducks::default_type> || detail::vec<typename T::BASE>);
 } // namespace coord
 } // namespace ducks
 } // namespace kittens
\ No newline at end of file
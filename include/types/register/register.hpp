@@ -1 +1,2 @@
-#include "rt.hpp"
\ No newline at end of file
+#include "rt.hpp"
+#include "rv.hpp"
\ No newline at end of file
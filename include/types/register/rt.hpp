@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rt_base.hpp"
+#include "rv.hpp"
 #include <concepts>
 #include <type_traits>
 
@@ -38,6 +39,9 @@ struct rt {
 
   base_tile tiles[height][width]; ///< The actual storage for the matrix tile, organized in subtiles.
 
+  using row_vec = rv<T, cols, typename base_tile::row_vec_layout>; ///< A type representing a row vector for this tile.
+  using col_vec = rv<T, rows, typename base_tile::col_vec_layout>; ///< A type representing a column vector for this tile.
+
   __device__ inline void operator=(const T &value) {
     T2 value2 = base_types::packing<T>::pack(value);
 #pragma unroll
@@ -116,4 +120,8 @@ template <int _r, int _c, ducks::rt_layout::all layout = ducks::rt_layout::row>
 using rt_bf = rt<bf16, _r, _c, layout>;
 template <int _r, int _c, ducks::rt_layout::all layout = ducks::rt_layout::row>
 using rt_hf = rt<half, _r, _c, layout>;
+template <int _r, int _c, ducks::rt_layout::all layout = ducks::rt_layout::row>
+using rt_fp8e4m3 = rt<fp8e4m3, _r, _c, layout>;
+template <int _r, int _c, ducks::rt_layout::all layout = ducks::rt_layout::row>
+using rt_fp8e5m2 = rt<fp8e5m2, _r, _c, layout>;
 } // namespace kittens
\ No newline at end of file
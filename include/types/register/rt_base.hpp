@@ -9,7 +9,7 @@
 
 #include "../../common/common.hpp"
 #include "rt_layout.hpp"
-// #include "rv_layout.hpp"
+#include "rv_layout.hpp"
 
 namespace kittens {
 
@@ -17,6 +17,11 @@ template <typename T>
 constexpr int TILE_ROW_DIM = 32;
 template <typename T>
 constexpr int TILE_COL_DIM = 16;
+// fp8 base tiles are 32 wide, so each lane still holds one 16-byte row fragment and feeds two MFMA k-steps
+template <>
+constexpr int TILE_COL_DIM<fp8e4m3> = 32;
+template <>
+constexpr int TILE_COL_DIM<fp8e5m2> = 32;
 
 /* ----------  BASE 16x16 SUBTILE STRUCT  ---------- */
 
@@ -58,19 +63,28 @@ struct rt_base {
   using dtype = T2; ///< Data type of the matrix elements
 
   static_assert(
-      std::is_same_v<dtype, bf16_2> || std::is_same_v<dtype, float2> || std::is_same_v<dtype, half_2>,
+      std::is_same_v<dtype, bf16_2> || std::is_same_v<dtype, float2> || std::is_same_v<dtype, half_2> ||
+          std::is_same_v<dtype, fp8e4m3_4> || std::is_same_v<dtype, fp8e5m2_4>,
       "rt_base was provided an unsupported type.");
 
   static constexpr int tile_size_row = kittens::TILE_ROW_DIM<T>; // < Tile size is a constant 16 for everyone
   static constexpr int tile_size_col = kittens::TILE_COL_DIM<T>;
   static constexpr int rows = tile_size_row;                              ///< Number of rows.
   static constexpr int cols = tile_size_col;                              ///< Number of cols.
-  static constexpr int num_elements = rows * cols;                        // 256 (64 for fp8e4m3)
-  static constexpr int elements_per_thread = num_elements / WAVE_THREADS; // 8 (2 for fp8e4m3)
+  static constexpr int num_elements = rows * cols;                        // 512 (1024 for fp8)
+  static constexpr int elements_per_thread = num_elements / WAVE_THREADS; // 8 (16 for fp8)
 
   static constexpr int packed_per_thread = (elements_per_thread / base_types::packing<dtype>::num()); // 4
   static constexpr int registers_per_thread = packed_per_thread * sizeof(dtype) / 4;                  // 4 or 8, registers are 32-bit words
 
+  // fp8 tiles are only ever MFMA operands; no instruction defines a col (accumulator) layout for them
+  static_assert(!ducks::base_types::fp8<T> || std::is_same_v<layout, ducks::rt_layout::row>, "fp8 register tiles must use the row layout.");
+
+  using row_vec_layout = std::conditional_t<std::is_same_v<layout, ducks::rt_layout::row>,
+                                            std::conditional_t<ducks::base_types::fp8<T>, ducks::rv_layout::align_row_fp8, ducks::rv_layout::align_row>,
+                                            ducks::rv_layout::ortho>; // for holding column reductions
+  using col_vec_layout = std::conditional_t<std::is_same_v<layout, ducks::rt_layout::row>, ducks::rv_layout::ortho, ducks::rv_layout::align_col>; // for holding row reductions
+
   dtype data[packed_per_thread]; ///< The actual storage for the base tile
 };
 
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @brief Register vectors: one value per row or column of a register tile, laid out like the tile.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "../../common/common.hpp"
+#include "rv_layout.hpp"
+
+namespace kittens {
+
+/* ----------  MAIN VECTOR STRUCT  ---------- */
+
+namespace ducks {
+/**
+ * @namespace rv
+ *
+ * @brief The namespace where concepts and abstract types for register vectors live.
+ */
+namespace rv {
+/**
+ * @brief A dummy type used to identify register vectors.
+ *
+ * For a type to quack like an rv, it should define its identifier as ducks::rv::identifier.
+ * If a type quacks like ducks::rv::identifier, it will be treated as an rv by compiler checks.
+ */
+struct identifier {};
+} // namespace rv
+} // namespace ducks
+
+/**
+ * @brief Register vector structure.
+ *
+ * @tparam _T The element type of the vector.
+ * @tparam _length The number of elements in the vector.
+ * @tparam _layout The distribution of the elements across lanes; see rt_base::row_vec_layout and col_vec_layout.
+ *
+ * Register vectors are used to accumulate and map values across the rows or columns of a register tile,
+ * for example a per-row scale or a per-column bias. data[o] holds this lane's share of the o-th chunk
+ * of layout::tile_size elements.
+ */
+template <typename _T, int _length, ducks::rv_layout::all _layout = ducks::rv_layout::ortho>
+struct rv {
+  using identifier = ducks::rv::identifier;          ///< Type identifier for the rv structure.
+  using layout = _layout;                            ///< Layout of the vector.
+  static_assert(kittens::ducks::base_types::T1<_T>); // confirm it's a supported type
+  using T = kittens::base_types::packing<_T>::unpacked_type;
+  using T2 = kittens::base_types::packing<_T>::packed_type;
+  using dtype = std::conditional_t<layout::packed, T2, T>; ///< Data type of the vector elements
+
+  static constexpr int length = _length; ///< Length in elements.
+  static_assert(length % layout::tile_size == 0, "Length must be divisible by the tile size of the layout");
+  static constexpr int tile_size = layout::tile_size;                                       ///< Elements per chunk.
+  static constexpr int outer_dim = length / tile_size;                                      ///< Number of chunks.
+  static constexpr int elements_per_lane = layout::elements_per_lane;                       ///< Elements of each chunk held per lane.
+  static constexpr int inner_dim = elements_per_lane / base_types::packing<dtype>::num(); ///< Packed values of each chunk held per lane.
+
+  dtype data[outer_dim][inner_dim]; ///< The actual register vector data.
+
+  __device__ inline dtype *operator[](size_t idx) { return &data[idx][0]; }             ///< A wrapper for indexing into vector data.
+  __device__ inline const dtype *operator[](size_t idx) const { return &data[idx][0]; } ///< A wrapper for indexing into vector data.
+  __device__ inline dtype &operator[](int2 outin) { return data[outin.x][outin.y]; }   ///< A wrapper for indexing into vector data.
+  __device__ inline const dtype &operator[](int2 outin) const { return data[outin.x][outin.y]; }
+
+  __device__ inline void operator=(const T &value) {
+    dtype value2;
+    if constexpr (layout::packed) {
+      value2 = base_types::packing<T>::pack(value);
+    } else {
+      value2 = value;
+    }
+#pragma unroll
+    for (int i = 0; i < outer_dim; i++) {
+#pragma unroll
+      for (int j = 0; j < inner_dim; j++) {
+        data[i][j] = value2;
+      }
+    }
+  }
+  template <typename U>
+  __device__ inline void operator=(const rv<U, length, layout> &other) {
+    using U_dtype = typename rv<U, length, layout>::dtype;
+#pragma unroll
+    for (int i = 0; i < outer_dim; i++) {
+#pragma unroll
+      for (int j = 0; j < inner_dim; j++) {
+        data[i][j] = base_types::convertor<dtype, U_dtype>::convert(other.data[i][j]);
+      }
+    }
+  }
+}; // struct rv
+
+/* ----------  CONCEPTS  ---------- */
+
+namespace ducks {
+namespace rv {
+/**
+ * @brief Concept for all register vectors.
+ * @tparam T The type to check against the concept requirements.
+ *
+ * Requires:
+ * - T has a nested type identifier that is the same as rv::identifier.
+ */
+template <typename T>
+concept all = requires {
+  typename T::identifier;                                // Checks if T::identifier exists
+} && std::is_same_v<typename T::identifier, identifier>; // Checks if T::identifier is ducks::rv::identifier
+/**
+ * @brief Concept for register vectors with one value per lane, orthogonal to the elements a lane owns in its tile.
+ */
+template <typename T>
+concept ortho_layout = all<T> && std::is_same_v<typename T::layout, ducks::rv_layout::ortho>;
+/**
+ * @brief Concept for register vectors aligned with the elements a lane owns in its tile.
+ *
+ * align_row (align_row_fp8 for fp8) vectors go with row-layout tiles and align_col vectors with col-layout tiles.
+ */
+template <typename T>
+concept align_layout = all<T> && (std::is_same_v<typename T::layout, ducks::rv_layout::align_row> ||
+                                  std::is_same_v<typename T::layout, ducks::rv_layout::align_row_fp8> ||
+                                  std::is_same_v<typename T::layout, ducks::rv_layout::align_col>);
+
+} // namespace rv
+} // namespace ducks
+
+/* ----------  WRAPPERS FOR PRETTINESS  ---------- */
+
+template <int _l, ducks::rv_layout::all layout = ducks::rv_layout::ortho>
+using rv_fl = rv<float, _l, layout>;
+template <int _l, ducks::rv_layout::all layout = ducks::rv_layout::ortho>
+using rv_bf = rv<bf16, _l, layout>;
+template <int _l, ducks::rv_layout::all layout = ducks::rv_layout::ortho>
+using rv_hf = rv<half, _l, layout>;
+
+} // namespace kittens
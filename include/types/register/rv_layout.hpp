@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @brief Layouts and their manipulations for register vectors.
+ */
+
+#pragma once
+
+#include <concepts>
+
+#include "../../common/common.hpp"
+
+namespace kittens {
+namespace ducks {
+/**
+ * @namespace rv_layout
+ *
+ * @brief A namespace for template metaprogramming with register vector layouts.
+ *
+ * A register vector holds one value per row or per column of a register tile, spread across the lanes
+ * the same way the tile is, so that each lane already has the values for the elements it owns. Each
+ * layout covers the vector in chunks of tile_size elements; a lane holds elements_per_lane of every
+ * chunk, and element e of its share is vector element idx(lane, e) of the chunk. Every element is held by
+ * several lanes; owner(lane) picks one copy of each, for stores.
+ */
+namespace rv_layout {
+
+/**
+ * @brief One value per lane: lane l holds element l % 32 of every 32-element chunk.
+ *
+ * Matches the rows of a row-layout tile (lane l owns row l % 32) and the columns of a col-layout tile
+ * (lane l owns column l % 32 of each 32-column accumulator). Lanes l and l + 32 hold the same values.
+ */
+struct ortho {
+  static constexpr int tile_size = 32;
+  static constexpr int elements_per_lane = 1;
+  static constexpr bool packed = false;
+  __host__ __device__ static inline constexpr int idx(int lane, int) { return lane % 32; }
+  __host__ __device__ static inline constexpr bool owner(int lane) { return lane < 32; }
+};
+/**
+ * @brief Matches the columns of a row-layout base tile: lane l holds elements 8 * (l / 32) + [0, 8) of every 16.
+ *
+ * Lanes l and l' hold the same values when l / 32 == l' / 32.
+ */
+struct align_row {
+  static constexpr int tile_size = 16;
+  static constexpr int elements_per_lane = 8;
+  static constexpr bool packed = true;
+  __host__ __device__ static inline constexpr int idx(int lane, int e) { return 8 * (lane / 32) + e; }
+  __host__ __device__ static inline constexpr bool owner(int lane) { return lane % 32 == 0; }
+};
+/**
+ * @brief Matches the columns of a row-layout fp8 base tile: lane l holds elements 16 * (l / 32) + [0, 16) of every 32.
+ *
+ * fp8 base tiles are 32 wide, so each lane's 16-byte row fragment covers twice as many columns as align_row's.
+ * Lanes l and l' hold the same values when l / 32 == l' / 32.
+ */
+struct align_row_fp8 {
+  static constexpr int tile_size = 32;
+  static constexpr int elements_per_lane = 16;
+  static constexpr bool packed = true;
+  __host__ __device__ static inline constexpr int idx(int lane, int e) { return 16 * (lane / 32) + e; }
+  __host__ __device__ static inline constexpr bool owner(int lane) { return lane % 32 == 0; }
+};
+/**
+ * @brief Matches the rows of a col-layout (MFMA accumulator) tile.
+ *
+ * Lane l holds elements 8 * q + 4 * (l / 32) + [0, 4) of every 32, for q in [0, 4): the rows its accumulator
+ * registers cover in both base tiles of a 32x32 accumulator. Lanes l and l' hold the same values when
+ * l / 32 == l' / 32.
+ */
+struct align_col {
+  static constexpr int tile_size = 32;
+  static constexpr int elements_per_lane = 16;
+  static constexpr bool packed = true;
+  __host__ __device__ static inline constexpr int idx(int lane, int e) { return 8 * (e / 4) + 4 * (lane / 32) + e % 4; }
+  __host__ __device__ static inline constexpr bool owner(int lane) { return lane % 32 == 0; }
+};
+
+/**
+ * @brief A concept to check if a type is a register vector layout.
+ */
+template <typename T>
+concept all = std::is_same_v<T, ortho> || std::is_same_v<T, align_row> || std::is_same_v<T, align_row_fp8> || std::is_same_v<T, align_col>;
+
+} // namespace rv_layout
+} // namespace ducks
+} // namespace kittens
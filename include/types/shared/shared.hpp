@@ -0,0 +1,8 @@
+/**
+ * @file
+ * @brief An aggregate header file for all the shared types defined by ThunderKittens.
+ */
+
+#pragma once
+
+#include "st.hpp"
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @brief The shared memory tile, used to stage data between global memory and registers.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <type_traits>
+
+#include "../../common/common.hpp"
+#include "../register/rt_base.hpp"
+#include "st_layout.hpp"
+
+namespace kittens {
+namespace ducks {
+/**
+ * @namespace st
+ *
+ * @brief The namespace where concepts and abstract types for shared tiles live.
+ */
+namespace st {
+/**
+ * @brief A dummy type used to identify shared tiles.
+ */
+struct identifier {};
+} // namespace st
+} // namespace ducks
+
+/**
+ * @brief Shared memory tile structure.
+ *
+ * @tparam _T The element type of the tile.
+ * @tparam _rows The height of the tile, a multiple of the register base tile height (32).
+ * @tparam _cols The width of the tile, a multiple of the register base tile width (16).
+ * @tparam _layout The layout of the tile in LDS.
+ *
+ * Allocate these with shared_allocator; they are far too large to live on the stack.
+ */
+template <typename _T, int _rows, int _cols, ducks::st_layout::all _layout = ducks::st_layout::swizzle>
+struct KITTENS_DEFAULT_ALIGN st {
+  using identifier = ducks::st::identifier; ///< Type identifier for the st structure.
+  using layout = _layout;                   ///< Layout of the tile in LDS.
+  static_assert(kittens::ducks::base_types::T1<_T>); // confirm it's a supported type
+  using T = kittens::base_types::packing<_T>::unpacked_type;
+  using T2 = kittens::base_types::packing<_T>::packed_type;
+  using dtype = T; ///< Data type of the elements in the tile.
+
+  static constexpr int rows = _rows; ///< Total number of rows.
+  static_assert(rows % TILE_ROW_DIM<T> == 0, "Rows must be divisible by the register tile size (32)");
+  static constexpr int cols = _cols; ///< Total number of columns.
+  static_assert(cols % TILE_COL_DIM<T> == 0, "Columns must be divisible by the register tile size (16)");
+  static constexpr int height = rows / TILE_ROW_DIM<T>; ///< Height in register subtiles.
+  static constexpr int width = cols / TILE_COL_DIM<T>;  ///< Width in register subtiles.
+  static constexpr int num_elements = rows * cols;      ///< Total number of elements.
+
+  static constexpr int elements_per_chunk = 16 / sizeof(T);                  ///< Elements per 16-byte LDS access.
+  static constexpr int chunks_per_row = cols / elements_per_chunk;           ///< 16-byte chunks per row.
+  static constexpr int num_chunks = num_elements / elements_per_chunk;       ///< 16-byte chunks in the tile.
+  static constexpr int row_bytes = cols * sizeof(T);                         ///< Bytes per row.
+  static constexpr int rows_per_line = row_bytes < 128 ? 128 / row_bytes : 1; ///< Rows sharing a 128-byte line.
+
+  dtype data[num_elements]; ///< Raw storage, addressed through idx().
+
+  /**
+   * @brief Index into data of the element at (row, col), after swizzling.
+   */
+  __host__ __device__ static inline int idx(int row, int col) {
+    const int linear = row * cols + col;
+    if constexpr (std::is_same_v<layout, ducks::st_layout::swizzle>) {
+      const int chunk = (linear / elements_per_chunk) ^ ((row / rows_per_line) % 8);
+      return chunk * elements_per_chunk + linear % elements_per_chunk;
+    } else {
+      return linear;
+    }
+  }
+
+  __host__ __device__ inline dtype &operator[](const int2 &rowcol) { return data[idx(rowcol.x, rowcol.y)]; }
+  __host__ __device__ inline const dtype &operator[](const int2 &rowcol) const { return data[idx(rowcol.x, rowcol.y)]; }
+};
+
+/* ----------  CONCEPTS  ---------- */
+
+namespace ducks {
+namespace st {
+/**
+ * @brief Concept for all shared tiles.
+ * @tparam T The type to check against the concept requirements.
+ *
+ * Requires:
+ * - T has a nested type identifier that is the same as st::identifier.
+ */
+template <typename T>
+concept all = requires {
+  typename T::identifier;                                // Checks if T::identifier exists
+} && std::is_same_v<typename T::identifier, identifier>; // Checks if T::identifier is ducks::st::identifier
+} // namespace st
+} // namespace ducks
+
+/* ----------  WRAPPERS FOR PRETTINESS  ---------- */
+
+template <int _r, int _c, ducks::st_layout::all layout = ducks::st_layout::swizzle>
+using st_bf = st<bf16, _r, _c, layout>;
+template <int _r, int _c, ducks::st_layout::all layout = ducks::st_layout::swizzle>
+using st_hf = st<half, _r, _c, layout>;
+template <int _r, int _c, ducks::st_layout::all layout = ducks::st_layout::swizzle>
+using st_fl = st<float, _r, _c, layout>;
+template <int _r, int _c, ducks::st_layout::all layout = ducks::st_layout::swizzle>
+using st_fp8e4m3 = st<fp8e4m3, _r, _c, layout>;
+template <int _r, int _c, ducks::st_layout::all layout = ducks::st_layout::swizzle>
+using st_fp8e5m2 = st<fp8e5m2, _r, _c, layout>;
+} // namespace kittens
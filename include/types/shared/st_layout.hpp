@@ -0,0 +1,40 @@
+/**
+ * @file
+ * @brief Layouts for shared memory tiles.
+ */
+
+#pragma once
+
+#include <concepts>
+
+namespace kittens {
+namespace ducks {
+/**
+ * @namespace st_layout
+ *
+ * @brief A namespace for template metaprogramming with shared tile layouts.
+ */
+namespace st_layout {
+
+/**
+ * @brief A dummy type used to identify a plain row-major shared tile.
+ */
+struct naive {};
+/**
+ * @brief A dummy type used to identify a row-major shared tile whose 16-byte chunks are XOR-swizzled.
+ *
+ * Within every 128-byte line, the chunk index is XORed with a per-row key, so the 16-byte reads
+ * of an rt_base fragment (32 rows, 2 chunks per row) and the linear 16-byte writes of a
+ * global-to-shared copy both hit all 32 LDS banks without conflicts.
+ */
+struct swizzle {};
+
+/**
+ * @brief A concept to check if a type is a shared tile layout.
+ */
+template <typename T>
+concept all = std::is_same_v<T, naive> || std::is_same_v<T, swizzle>;
+
+} // namespace st_layout
+} // namespace ducks
+} // namespace kittens
@@ -1,2 +1,3 @@
 #include "register/register.hpp"
+#include "shared/shared.hpp"
 #include "global/global.hpp"
\ No newline at end of file
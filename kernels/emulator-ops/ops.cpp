@@ -0,0 +1,335 @@
+// Checks register tile ops on the host wavefront emulator against host references: row and column
+// reductions, maps of row and column vectors over tiles, every mma_AB/ABt/AtB/AtBt form, and an fp8
+// GEMM with per-row and per-column scales. Results are compared register by register with the reference loaded into the same layout, so
+// every lane's copy of a vector element is checked, not just the one a store would write.
+// No GPU is needed: build with the Makefile next to this file. The exit status is nonzero on a mismatch.
+#include <random>
+#include <kittens.hpp>
+
+using namespace kittens;
+
+/**
+ * @brief n integers drawn uniformly from [lo, hi], as floats.
+ *
+ * Small integers keep bf16 sums exact, so reductions can be compared bit for bit.
+ */
+std::vector<float> integers(size_t n, int lo, int hi, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(lo, hi);
+  std::vector<float> v(n);
+  for (float &x : v) x = float(dist(gen));
+  return v;
+}
+
+/**
+ * @brief Loads a rows x cols host matrix (or a vector, with rows = 1) into a register tile or vector of every lane.
+ */
+template <typename R>
+emulator::wave<R> load_host(const std::vector<float> &values, int rows, int cols) {
+  using T = typename R::T;
+  std::vector<T> data(values.size());
+  for (size_t i = 0; i < values.size(); i++) data[i] = base_types::convertor<T, float>::convert(values[i]);
+  gl<T, 1, 1, -1, -1> g(data.data(), nullptr, nullptr, rows, cols);
+  emulator::wave<R> dst;
+  emulator::load(dst, g, {0});
+  return dst;
+}
+
+/**
+ * @brief Every register of every lane, as floats.
+ */
+template <typename R>
+std::vector<float> registers(const emulator::wave<R> &src) {
+  using T = typename R::T;
+  constexpr size_t per_lane = sizeof(R) / sizeof(T);
+  std::vector<float> v(WAVE_THREADS * per_lane);
+  for (int lane = 0; lane < WAVE_THREADS; lane++) {
+    const T *elems = reinterpret_cast<const T *>(&src[lane]);
+    for (size_t e = 0; e < per_lane; e++) v[lane * per_lane + e] = base_types::convertor<float, T>::convert(elems[e]);
+  }
+  return v;
+}
+
+/**
+ * @brief Compares the registers of actual with those of the reference loaded into the same layout, and prints one line.
+ */
+template <typename R>
+bool check(const std::string &what, const emulator::wave<R> &actual, const std::vector<float> &expected, int rows, int cols, float epsilon = 0.f) {
+  const std::vector<float> a = registers(actual), e = registers(load_host<R>(expected, rows, cols));
+  const compare_stats stats = compare_host(e.data(), a.data(), e.size(), epsilon);
+  const bool ok = stats.passed(0.f);
+  std::cout << what << ": " << (ok ? "ok" : "MISMATCH") << std::endl;
+  if (!ok) stats.print(0.f);
+  return ok;
+}
+
+/**
+ * @brief row_max/row_sum/col_max/col_sum of RT, both starting fresh and accumulating onto a vector.
+ */
+template <typename RT>
+bool reductions(const std::string &name) {
+  using col_vec = typename RT::col_vec;
+  using row_vec = typename RT::row_vec;
+  constexpr int M = RT::rows, N = RT::cols;
+  const std::vector<float> x = integers(M * N, -2, 2, 1);
+  const std::vector<float> row_prev = integers(M, -3, 3, 2), col_prev = integers(N, -3, 3, 3);
+  std::vector<float> row_max(M, -INFINITY), row_sum(M, 0.f), col_max(N, -INFINITY), col_sum(N, 0.f);
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      row_max[i] = std::max(row_max[i], x[i * N + j]);
+      row_sum[i] += x[i * N + j];
+      col_max[j] = std::max(col_max[j], x[i * N + j]);
+      col_sum[j] += x[i * N + j];
+    }
+  }
+  std::vector<float> row_max_acc(M), row_sum_acc(M), col_max_acc(N), col_sum_acc(N);
+  for (int i = 0; i < M; i++) {
+    row_max_acc[i] = std::max(row_prev[i], row_max[i]);
+    row_sum_acc[i] = row_prev[i] + row_sum[i];
+  }
+  for (int j = 0; j < N; j++) {
+    col_max_acc[j] = std::max(col_prev[j], col_max[j]);
+    col_sum_acc[j] = col_prev[j] + col_sum[j];
+  }
+
+  const emulator::wave<RT> tile = load_host<RT>(x, M, N);
+  const emulator::wave<col_vec> rows_in = load_host<col_vec>(row_prev, 1, M);
+  const emulator::wave<row_vec> cols_in = load_host<row_vec>(col_prev, 1, N);
+  emulator::wave<col_vec> rows;
+  emulator::wave<row_vec> cols;
+  bool ok = true;
+  emulator::row_max(rows, tile);
+  ok &= check(name + " row_max", rows, row_max, 1, M);
+  emulator::row_max(rows, tile, rows_in);
+  ok &= check(name + " row_max, accumulating", rows, row_max_acc, 1, M);
+  emulator::row_sum(rows, tile);
+  ok &= check(name + " row_sum", rows, row_sum, 1, M);
+  emulator::row_sum(rows, tile, rows_in);
+  ok &= check(name + " row_sum, accumulating", rows, row_sum_acc, 1, M);
+  emulator::col_max(cols, tile);
+  ok &= check(name + " col_max", cols, col_max, 1, N);
+  emulator::col_max(cols, tile, cols_in);
+  ok &= check(name + " col_max, accumulating", cols, col_max_acc, 1, N);
+  emulator::col_sum(cols, tile);
+  ok &= check(name + " col_sum", cols, col_sum, 1, N);
+  emulator::col_sum(cols, tile, cols_in);
+  ok &= check(name + " col_sum, accumulating", cols, col_sum_acc, 1, N);
+  return ok;
+}
+
+/**
+ * @brief n values drawn uniformly from +-1, +-2 and +-4, so products and quotients stay exact.
+ */
+std::vector<float> powers_of_two(size_t n, uint32_t seed) {
+  std::vector<float> v = integers(n, 0, 5, seed);
+  for (float &x : v) x = (int(x) % 2 ? -1.f : 1.f) * float(1 << (int(x) / 2));
+  return v;
+}
+
+/**
+ * @brief row_map/col_map, with one and two tiles, and the row and column wrappers over them.
+ */
+template <typename RT>
+bool maps(const std::string &name) {
+  using col_vec = typename RT::col_vec;
+  using row_vec = typename RT::row_vec;
+  constexpr int M = RT::rows, N = RT::cols;
+  const std::vector<float> x = integers(M * N, -4, 4, 4), y = integers(M * N, -4, 4, 5);
+  const std::vector<float> r = powers_of_two(M, 6), c = powers_of_two(N, 7);
+  // expected(f) is f(x, y, r, c) at every element, with r and c the values of its row and column
+  auto expected = [&](auto f) {
+    std::vector<float> e(M * N);
+    for (int i = 0; i < M; i++)
+      for (int j = 0; j < N; j++) e[i * N + j] = f(x[i * N + j], y[i * N + j], r[i], c[j]);
+    return e;
+  };
+
+  const emulator::wave<RT> a = load_host<RT>(x, M, N), b = load_host<RT>(y, M, N);
+  const emulator::wave<col_vec> rows = load_host<col_vec>(r, 1, M);
+  const emulator::wave<row_vec> cols = load_host<row_vec>(c, 1, N);
+  emulator::wave<RT> dst;
+  bool ok = true;
+  emulator::row_map<base_ops::max>(dst, a, rows);
+  ok &= check(name + " row_map max", dst, expected([](float x, float, float r, float) { return std::max(x, r); }), M, N);
+  emulator::col_map<base_ops::min>(dst, a, cols);
+  ok &= check(name + " col_map min", dst, expected([](float x, float, float, float c) { return std::min(x, c); }), M, N);
+  emulator::for_each_lane([&](int lane) { row_map<base_ops::fma_AxBtC>(dst[lane], a[lane], b[lane], rows[lane]); });
+  ok &= check(name + " row_map fma", dst, expected([](float x, float y, float r, float) { return x * y + r; }), M, N);
+  emulator::for_each_lane([&](int lane) { col_map<base_ops::fma_AxBtC>(dst[lane], a[lane], b[lane], cols[lane]); });
+  ok &= check(name + " col_map fma", dst, expected([](float x, float y, float, float c) { return x * y + c; }), M, N);
+
+  emulator::for_each_lane([&](int lane) { add_row(dst[lane], a[lane], rows[lane]); });
+  ok &= check(name + " add_row", dst, expected([](float x, float, float r, float) { return x + r; }), M, N);
+  emulator::for_each_lane([&](int lane) { sub_row(dst[lane], a[lane], rows[lane]); });
+  ok &= check(name + " sub_row", dst, expected([](float x, float, float r, float) { return x - r; }), M, N);
+  emulator::for_each_lane([&](int lane) { mul_row(dst[lane], a[lane], rows[lane]); });
+  ok &= check(name + " mul_row", dst, expected([](float x, float, float r, float) { return x * r; }), M, N);
+  emulator::for_each_lane([&](int lane) { div_row(dst[lane], a[lane], rows[lane]); });
+  ok &= check(name + " div_row", dst, expected([](float x, float, float r, float) { return x / r; }), M, N);
+  emulator::for_each_lane([&](int lane) { broadcast_row(dst[lane], rows[lane]); });
+  ok &= check(name + " broadcast_row", dst, expected([](float, float, float r, float) { return r; }), M, N);
+
+  emulator::for_each_lane([&](int lane) { add_col(dst[lane], a[lane], cols[lane]); });
+  ok &= check(name + " add_col", dst, expected([](float x, float, float, float c) { return x + c; }), M, N);
+  emulator::for_each_lane([&](int lane) { sub_col(dst[lane], a[lane], cols[lane]); });
+  ok &= check(name + " sub_col", dst, expected([](float x, float, float, float c) { return x - c; }), M, N);
+  emulator::for_each_lane([&](int lane) { mul_col(dst[lane], a[lane], cols[lane]); });
+  ok &= check(name + " mul_col", dst, expected([](float x, float, float, float c) { return x * c; }), M, N);
+  emulator::for_each_lane([&](int lane) { div_col(dst[lane], a[lane], cols[lane]); });
+  ok &= check(name + " div_col", dst, expected([](float x, float, float, float c) { return x / c; }), M, N);
+  emulator::for_each_lane([&](int lane) { broadcast_col(dst[lane], cols[lane]); });
+  ok &= check(name + " broadcast_col", dst, expected([](float, float, float, float c) { return c; }), M, N);
+  return ok;
+}
+
+/**
+ * @brief One MMA form against cpu_matmul, with A stored K x M when trans_a and B stored N x K when trans_b.
+ *
+ * Each operand is loaded from global memory in the register layout its form takes, so a transposed operand
+ * is read as stored, with no transpose pass.
+ */
+template <typename T, typename TC, bool trans_a, bool trans_b>
+bool mma_form(const std::string &name) {
+  constexpr int M = 64, N = 96, K = 128;
+  using a_tile = std::conditional_t<trans_a, rt<T, K, M, ducks::rt_layout::col>, rt<T, M, K, ducks::rt_layout::row>>;
+  using b_tile = std::conditional_t<trans_b, rt<T, N, K, ducks::rt_layout::row>, rt<T, K, N, ducks::rt_layout::col>>;
+  using c_tile = rt<TC, M, N, ducks::rt_layout::col>;
+  std::vector<T> A(M * K), B(N * K), C(M * N), C_ref(M * N);
+  rng::fill_host(A.data(), A.size(), trans_a ? K : M, trans_a ? M : K, rng::uniform{14});
+  rng::fill_host(B.data(), B.size(), trans_b ? N : K, trans_b ? K : N, rng::uniform{15});
+  cpu_matmul<T, trans_a, trans_b>(A.data(), B.data(), C_ref.data(), M, N, K);
+
+  gl<T, 1, 1, -1, -1> g_A(A.data(), nullptr, nullptr, trans_a ? K : M, trans_a ? M : K);
+  gl<T, 1, 1, -1, -1> g_B(B.data(), nullptr, nullptr, trans_b ? N : K, trans_b ? K : N);
+  gl<T, 1, 1, -1, -1> g_C(C.data(), nullptr, nullptr, M, N);
+  emulator::wave<a_tile> a;
+  emulator::wave<b_tile> b;
+  emulator::wave<c_tile> c;
+  emulator::load(a, g_A, {0, 0});
+  emulator::load(b, g_B, {0, 0});
+  emulator::zero(c);
+  if constexpr (!trans_a && !trans_b) emulator::mma_AB(c, a, b);
+  else if constexpr (!trans_a && trans_b) emulator::mma_ABt(c, a, b);
+  else if constexpr (trans_a && !trans_b) emulator::mma_AtB(c, a, b);
+  else emulator::mma_AtBt(c, a, b);
+  emulator::store(g_C, c, {0, 0});
+
+  const compare_stats stats = compare_host(C_ref.data(), C.data(), C.size());
+  const bool ok = stats.passed(0.f);
+  std::cout << name << ": " << (ok ? "ok" : "MISMATCH") << std::endl;
+  if (!ok) stats.print(0.f);
+  return ok;
+}
+
+/**
+ * @brief The largest finite value of an FNUZ fp8 type.
+ */
+template <typename T>
+constexpr float fp8_max = std::is_same_v<T, fp8e4m3> ? 240.f : 57344.f;
+
+/**
+ * @brief x * scale rounded to T, as load_scaled() does it, and back to fp32.
+ */
+template <typename T>
+float quantized(float x, float scale) {
+  return base_types::convertor<float, T>::convert(base_types::convertor<T, float>::convert(x * scale));
+}
+
+/**
+ * @brief C = diag(row_scale) * A * B^T * diag(col_scale), with A quantized to e4m3 and B to TB on the way
+ * into registers, and the scales applied to the fp32 accumulator.
+ *
+ * A and B get per-tensor quantization scales, through load_scaled; their inverses are folded into the row
+ * and column scale vectors. The host reference multiplies the same quantized values.
+ */
+template <typename TB>
+bool fp8_gemm(const std::string &name) {
+  constexpr int M = 64, N = 96, K = 128;
+  using a_tile = rt<fp8e4m3, M, K>;
+  using b_tile = rt<TB, N, K>;
+  using c_tile = rt_fl<M, N, ducks::rt_layout::col>;
+  std::vector<float> A(M * K), B(N * K), row_scale(M), col_scale(N);
+  rng::fill_host(A.data(), A.size(), M, K, rng::uniform{8});
+  rng::fill_host(B.data(), B.size(), N, K, rng::uniform{9, -3.f, 3.f});
+  rng::fill_host(row_scale.data(), row_scale.size(), 1, M, rng::uniform{10, 0.5f, 2.f});
+  rng::fill_host(col_scale.data(), col_scale.size(), 1, N, rng::uniform{11, 0.5f, 2.f});
+  auto amax = [](const std::vector<float> &x) {
+    float m = 0;
+    for (float v : x) m = std::max(m, std::abs(v));
+    return m;
+  };
+  const float scale_A = fp8_max<fp8e4m3> / amax(A), scale_B = fp8_max<TB> / amax(B);
+
+  std::vector<float> row_descale(M), col_descale(N), C_ref(M * N);
+  for (int i = 0; i < M; i++) row_descale[i] = row_scale[i] / scale_A;
+  for (int j = 0; j < N; j++) col_descale[j] = col_scale[j] / scale_B;
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      float acc = 0;
+      for (int k = 0; k < K; k++) acc += quantized<fp8e4m3>(A[i * K + k], scale_A) * quantized<TB>(B[j * K + k], scale_B);
+      C_ref[i * N + j] = acc * row_descale[i] * col_descale[j];
+    }
+  }
+
+  gl<float, 1, 1, -1, -1> g_A(A.data(), nullptr, nullptr, M, K), g_B(B.data(), nullptr, nullptr, N, K);
+  emulator::wave<a_tile> a;
+  emulator::wave<b_tile> b;
+  emulator::wave<c_tile> c;
+  emulator::load_scaled(a, g_A, {0, 0}, scale_A);
+  emulator::load_scaled(b, g_B, {0, 0}, scale_B);
+  emulator::zero(c);
+  emulator::mma_ABt(c, a, b);
+  const emulator::wave<typename c_tile::col_vec> rows = load_host<typename c_tile::col_vec>(row_descale, 1, M);
+  const emulator::wave<typename c_tile::row_vec> cols = load_host<typename c_tile::row_vec>(col_descale, 1, N);
+  emulator::for_each_lane([&](int lane) {
+    mul_row(c[lane], c[lane], rows[lane]);
+    mul_col(c[lane], c[lane], cols[lane]);
+  });
+  std::vector<float> C(M * N);
+  gl<float, 1, 1, -1, -1> g_C(C.data(), nullptr, nullptr, M, N);
+  emulator::store(g_C, c, {0, 0});
+
+  // Only the order of the fp32 sums differs from the reference
+  const compare_stats stats = compare_host(C_ref.data(), C.data(), C.size(), 1e-3f);
+  bool ok = stats.passed(0.f);
+  std::cout << name << " scaled GEMM: " << (ok ? "ok" : "MISMATCH") << std::endl;
+  if (!ok) stats.print(0.f);
+
+  // A tile whose rows are all v holds, in every lane, the same bytes as v loaded as the tile's row vector
+  std::vector<float> v(K), broadcast(M * K);
+  rng::fill_host(v.data(), v.size(), 1, K, rng::uniform{12});
+  for (int i = 0; i < M; i++) std::copy(v.begin(), v.end(), broadcast.begin() + i * K);
+  std::vector<float> v_scaled(K);
+  for (int k = 0; k < K; k++) v_scaled[k] = v[k] * scale_A;
+  gl<float, 1, 1, -1, -1> g_broadcast(broadcast.data(), nullptr, nullptr, M, K);
+  emulator::load_scaled(a, g_broadcast, {0, 0}, scale_A);
+  const emulator::wave<typename a_tile::row_vec> a_cols = load_host<typename a_tile::row_vec>(v_scaled, 1, K);
+  bool aligned = true;
+  for (int lane = 0; lane < WAVE_THREADS; lane++)
+    for (int i = 0; i < a_tile::height; i++)
+      for (int j = 0; j < a_tile::width; j++) aligned &= std::memcmp(a_cols[lane].data[j], a[lane].tiles[i][j].data, sizeof(a_cols[lane].data[j])) == 0;
+  std::cout << name << " row vector layout: " << (aligned ? "ok" : "MISMATCH") << std::endl;
+  return ok && aligned;
+}
+
+int main() {
+  bool ok = true;
+  // Not square, so a row reduction landing in a column vector (or the reverse) cannot match
+  ok &= reductions<rt_bf<64, 96>>("rt_bf<64, 96> row");
+  ok &= reductions<rt_fl<64, 96, ducks::rt_layout::col>>("rt_fl<64, 96> col");
+  ok &= maps<rt_bf<64, 96>>("rt_bf<64, 96> row");
+  ok &= maps<rt_fl<64, 96, ducks::rt_layout::col>>("rt_fl<64, 96> col");
+  ok &= mma_form<bf16, float, false, false>("mma_AB bf16, fp32 accumulator");
+  ok &= mma_form<bf16, float, false, true>("mma_ABt bf16, fp32 accumulator");
+  ok &= mma_form<bf16, float, true, false>("mma_AtB bf16, fp32 accumulator");
+  ok &= mma_form<bf16, float, true, true>("mma_AtBt bf16, fp32 accumulator");
+  ok &= mma_form<half, half, false, false>("mma_AB fp16, fp16 accumulator");
+  ok &= mma_form<half, half, false, true>("mma_ABt fp16, fp16 accumulator");
+  ok &= mma_form<half, float, true, false>("mma_AtB fp16, fp32 accumulator");
+  ok &= mma_form<half, half, true, true>("mma_AtBt fp16, fp16 accumulator");
+  ok &= fp8_gemm<fp8e4m3>("e4m3 x e4m3");
+  ok &= fp8_gemm<fp8e5m2>("e4m3 x e5m2");
+
+  std::cout << (ok ? "All emulated ops match" : "Emulated ops FAILED") << std::endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// Runs the matmul-mfma kernel on the host wavefront emulator and checks it against cpu_matmul.
+// No GPU is needed: build with the Makefile next to this file.
+#include <prototype/prototype.hpp>
+
+using namespace kittens;
+
+namespace mm_ABt_ker {
+struct layout {
+  // base sizes - feel free to change M/N dimensions on these
+  static constexpr coord_mnk wave_tile_count{2, 1, 4};
+  static constexpr coord_mnk block_wave_count{2, 2, 1};
+  static constexpr int num_stages = 3; // one deeper than matmul-mfma, so the prefetch ring wraps
+
+  // derived  (or constant) sizes - do not change these
+  static constexpr coord_mnk mma_atom_size{32, 32, 16};
+  static constexpr coord_mnk wave_size = mma_atom_size * wave_tile_count;
+  static constexpr int num_waves = block_wave_count.m * block_wave_count.n * block_wave_count.k;
+  static constexpr coord_mnk block_size = wave_size * block_wave_count;
+};
+struct locals {
+  using layout = mm_ABt_ker::layout;
+  static constexpr int wave_tile_size_m = layout::wave_tile_count.m * layout::mma_atom_size.m;
+  static constexpr int wave_tile_size_n = layout::wave_tile_count.n * layout::mma_atom_size.n;
+
+  emulator::wave<rt_bf<wave_tile_size_m, layout::wave_size.k>> a_reg;
+  emulator::wave<rt_bf<wave_tile_size_n, layout::wave_size.k>> b_reg;
+  emulator::wave<rt_fl<wave_tile_size_m, wave_tile_size_n, ducks::rt_layout::col>> c_reg;
+};
+// The device main loop cannot run here (it synchronizes the block), but its types and schedule are reused
+using mainloop = prototype::gemm::mainloop_ABt<layout, layout::num_stages, /* bounded */ true>;
+using smem = mainloop::smem;
+struct prefetch {
+  mainloop::G::prefetch_buffer<mainloop::a_tile> a_next[mainloop::prefetch_depth][WAVE_THREADS];
+  mainloop::G::prefetch_buffer<mainloop::b_tile> b_next[mainloop::prefetch_depth][WAVE_THREADS];
+};
+struct globals {
+  using abc_t = gl<bf16, -1, -1, -1, -1>;
+  abc_t A, B, C;
+  raster_order raster;
+};
+}; // namespace mm_ABt_ker
+
+using layout = mm_ABt_ker::layout;
+
+// Each for_each_wave below is one phase of the device kernel, between two __syncthreads().
+void emulated_matmul_ABt_ker(mm_ABt_ker::globals &g, dim3 block) {
+  constexpr int depth = mm_ABt_ker::mainloop::prefetch_depth;
+  using G = mm_ABt_ker::mainloop::G;
+  mm_ABt_ker::smem s;
+  mm_ABt_ker::locals l[layout::num_waves];
+  mm_ABt_ker::prefetch p[layout::num_waves];
+
+  const int tiles_m = (g.C.rows() + layout::block_size.m - 1) / layout::block_size.m;
+  const int tiles_n = (g.C.cols() + layout::block_size.n - 1) / layout::block_size.n;
+  const coord_mnk tile = rasterize(block.x, tiles_m, tiles_n, g.raster);
+  int block_m = tile.m, block_n = tile.n;
+  int num_k_tiles = (g.A.cols() + layout::block_size.k - 1) / layout::block_size.k;
+  emulator::for_each_wave(layout::num_waves, [&](int wave) {
+    emulator::zero(l[wave].c_reg);
+    emulator::for_each_lane([&](int lane) {
+      if (num_k_tiles > 0) {
+        G::load_bounded(s.a[0], g.A, {block_m, 0});
+        G::load_bounded(s.b[0], g.B, {block_n, 0});
+      }
+      for (int k = 1; k < depth && k < num_k_tiles; k++) {
+        G::prefetch_bounded(p[wave].a_next[k][lane], g.A, {block_m, k});
+        G::prefetch_bounded(p[wave].b_next[k][lane], g.B, {block_n, k});
+      }
+    });
+  });
+  for (int k = 0; k < num_k_tiles; k++) {
+    const int next = k + depth;
+    emulator::for_each_wave(layout::num_waves, [&](int wave) {
+      if (next < num_k_tiles) {
+        emulator::for_each_lane([&](int lane) {
+          G::prefetch_bounded(p[wave].a_next[k % depth][lane], g.A, {block_m, next});
+          G::prefetch_bounded(p[wave].b_next[k % depth][lane], g.B, {block_n, next});
+        });
+      }
+      emulator::load(l[wave].a_reg, s.a[k % 2], {wave / layout::block_wave_count.n, 0});
+      emulator::load(l[wave].b_reg, s.b[k % 2], {wave % layout::block_wave_count.n, 0});
+      emulator::mma_ABt(l[wave].c_reg, l[wave].a_reg, l[wave].b_reg);
+      if (k + 1 < num_k_tiles) {
+        emulator::for_each_lane([&](int lane) {
+          G::commit(s.a[(k + 1) % 2], p[wave].a_next[(k + 1) % depth][lane]);
+          G::commit(s.b[(k + 1) % 2], p[wave].b_next[(k + 1) % depth][lane]);
+        });
+      }
+    });
+  }
+  emulator::for_each_wave(layout::num_waves, [&](int wave) {
+    int wave_start_m = block_m * (layout::block_size.m / layout::wave_size.m) + wave / layout::block_wave_count.n;
+    int wave_start_n = block_n * (layout::block_size.n / layout::wave_size.n) + wave % layout::block_wave_count.n;
+    emulator::store_bounded(g.C, l[wave].c_reg, {wave_start_m, wave_start_n});
+  });
+}
+
+void emulated_matmul_ABt(bf16 *A, bf16 *B, bf16 *C, int M, int N, int K) {
+  dim3 grid(((M + layout::block_size.m - 1) / layout::block_size.m) * ((N + layout::block_size.n - 1) / layout::block_size.n));
+  std::cout << "Problem Shape: (" << M << ", " << N << ", " << K << ")" << std::endl;
+  std::cout << "Emulating grid (" << grid.x << ", " << grid.y << ", " << grid.z << ") with " << layout::num_waves << " waves per block" << std::endl;
+
+  using gl_t = mm_ABt_ker::globals::abc_t;
+  mm_ABt_ker::globals g{gl_t(A, 1, 1, M, K), gl_t(B, 1, 1, N, K), gl_t(C, 1, 1, M, N), raster_order::hilbert};
+
+  emulator::launch(grid, [&](dim3 block) { emulated_matmul_ABt_ker(g, block); });
+}
+
+int main(int argc, char **argv) {
+  int M = argc > 1 ? std::atoi(argv[1]) : 1024;
+  int N = argc > 2 ? std::atoi(argv[2]) : M;
+  int K = argc > 3 ? std::atoi(argv[3]) : M;
+
+  auto h_A = init_host<fill_random, bf16>(M * K);
+  auto h_B = init_host<fill_random, bf16>(K * N);
+  auto h_C = init_host<fill_zeros, bf16>(M * N);
+
+  auto h_C_ref = h_C;
+  cpu_matmul<bf16, /* A */ false, /* B.T */ true>(h_A.data(), h_B.data(), h_C_ref.data(), M, N, K);
+  emulated_matmul_ABt(h_A.data(), h_B.data(), h_C.data(), M, N, K);
+
+  assert_equal(h_C_ref, h_C);
+
+  return 0;
+}